@@ -245,6 +245,10 @@ void Allpix::terminate() {
     mod_mgr_->terminate();
 }
 
+RunStatistics Allpix::getRunStatistics() const {
+    return mod_mgr_->getRunStatistics();
+}
+
 /**
  * This style is inspired by the CLICdp plot style
  */
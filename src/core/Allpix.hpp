@@ -73,6 +73,13 @@ namespace allpix {
          */
         void terminate();
 
+        /**
+         * @brief Get the performance statistics of the run
+         * @return Statistics of the run
+         * @warning Should be called after the \ref Allpix::finalize "finalize function"
+         */
+        RunStatistics getRunStatistics() const;
+
     private:
         /**
          * @brief Set the default ROOT plot style
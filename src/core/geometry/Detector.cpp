@@ -31,14 +31,13 @@ Detector::Detector(std::string name,
                    ROOT::Math::XYZPoint position,
                    const ROOT::Math::Rotation3D& orientation)
     : Detector(std::move(name), std::move(position), orientation) {
-    model_ = std::move(model);
     // Check if valid model is supplied
-    if(model_ == nullptr) {
+    if(model == nullptr) {
         throw InvalidModuleActionException("Detector model cannot be a null pointer");
     }
 
-    // Build the transformation matrix
-    build_transform();
+    // Set the model, initializing the fields and building the transformation matrix
+    set_model(std::move(model));
 }
 
 /**
@@ -155,8 +154,10 @@ void Detector::setElectricFieldGrid(const std::shared_ptr<std::vector<double>>&
                                     std::array<size_t, 3> dimensions,
                                     std::array<double, 2> scales,
                                     std::array<double, 2> offset,
-                                    std::pair<double, double> thickness_domain) {
-    electric_field_.setGrid(field, dimensions, scales, offset, thickness_domain);
+                                    std::pair<double, double> thickness_domain,
+                                    std::array<bool, 2> reduced,
+                                    std::array<bool, 2> mirrored) {
+    electric_field_.setGrid(field, dimensions, scales, offset, thickness_domain, reduced, mirrored);
 }
 
 void Detector::setElectricFieldFunction(FieldFunction<ROOT::Math::XYZVector> function,
@@ -196,8 +197,10 @@ void Detector::setWeightingPotentialGrid(const std::shared_ptr<std::vector<doubl
                                          std::array<size_t, 3> dimensions,
                                          std::array<double, 2> scales,
                                          std::array<double, 2> offset,
-                                         std::pair<double, double> thickness_domain) {
-    weighting_potential_.setGrid(potential, dimensions, scales, offset, thickness_domain);
+                                         std::pair<double, double> thickness_domain,
+                                         std::array<bool, 2> reduced,
+                                         std::array<bool, 2> mirrored) {
+    weighting_potential_.setGrid(potential, dimensions, scales, offset, thickness_domain, reduced, mirrored);
 }
 
 void Detector::setWeightingPotentialFunction(FieldFunction<double> function,
@@ -258,8 +261,10 @@ void Detector::setDopingProfileGrid(std::shared_ptr<std::vector<double>> field,
                                     std::array<size_t, 3> dimensions,
                                     std::array<double, 2> scales,
                                     std::array<double, 2> offset,
-                                    std::pair<double, double> thickness_domain) {
-    doping_profile_.setGrid(std::move(field), dimensions, scales, offset, thickness_domain);
+                                    std::pair<double, double> thickness_domain,
+                                    std::array<bool, 2> reduced,
+                                    std::array<bool, 2> mirrored) {
+    doping_profile_.setGrid(std::move(field), dimensions, scales, offset, thickness_domain, reduced, mirrored);
 }
 
 void Detector::setDopingProfileFunction(FieldFunction<double> function, FieldType type) {
@@ -126,12 +126,16 @@ namespace allpix {
          * @param scales Scaling factors for the field size, given in fractions of a pixel unit cell in x and y
          * @param offset Offset of the field from the pixel border
          * @param thickness_domain Domain in local coordinates in the thickness direction where the field holds
+         * @param reduced Axes in x and y along which the field has been collapsed to a single bin from a larger grid
+         * @param mirrored Axes in x and y along which only the upper half of the mirror-symmetric field is provided
          */
         void setElectricFieldGrid(const std::shared_ptr<std::vector<double>>& field,
                                   std::array<size_t, 3> dimensions,
                                   std::array<double, 2> scales,
                                   std::array<double, 2> offset,
-                                  std::pair<double, double> thickness_domain);
+                                  std::pair<double, double> thickness_domain,
+                                  std::array<bool, 2> reduced = {},
+                                  std::array<bool, 2> mirrored = {});
         /**
          * @brief Set the electric field in a single pixel using a function
          * @param function Function used to retrieve the electric field
@@ -166,12 +170,16 @@ namespace allpix {
          * @param scales Scaling factors for the field size, given in fractions of a pixel unit cell in x and y
          * @param offset Offset of the field from the pixel border
          * @param thickness_domain Domain in local coordinates in the thickness direction where the profile holds
+         * @param reduced Axes in x and y along which the profile has been collapsed to a single bin from a larger grid
+         * @param mirrored Axes in x and y along which only the upper half of the mirror-symmetric profile is provided
          */
         void setDopingProfileGrid(std::shared_ptr<std::vector<double>> field,
                                   std::array<size_t, 3> dimensions,
                                   std::array<double, 2> scales,
                                   std::array<double, 2> offset,
-                                  std::pair<double, double> thickness_domain);
+                                  std::pair<double, double> thickness_domain,
+                                  std::array<bool, 2> reduced = {},
+                                  std::array<bool, 2> mirrored = {});
         /**
          * @brief Set the doping profile in a single pixel using a function
          * @param function Function used to retrieve the doping profile
@@ -205,12 +213,16 @@ namespace allpix {
          * @param scales Scaling factors for the field size, given in fractions of a pixel unit cell in x and y
          * @param offset Offset of the field from the pixel border
          * @param thickness_domain Domain in local coordinates in the thickness direction where the potential holds
+         * @param reduced Axes in x and y along which the potential has been collapsed to a single bin from a larger grid
+         * @param mirrored Axes in x and y along which only the upper half of the mirror-symmetric potential is provided
          */
         void setWeightingPotentialGrid(const std::shared_ptr<std::vector<double>>& potential,
                                        std::array<size_t, 3> dimensions,
                                        std::array<double, 2> scales,
                                        std::array<double, 2> offset,
-                                       std::pair<double, double> thickness_domain);
+                                       std::pair<double, double> thickness_domain,
+                                       std::array<bool, 2> reduced = {},
+                                       std::array<bool, 2> mirrored = {});
         /**
          * @brief Set the weighting potential in a single pixel using a function
          * @param function Function used to retrieve the weighting potential
@@ -103,12 +103,16 @@ namespace allpix {
          * @param scales The actual physical extent of the field in each direction in x and y
          * @param offset Offset of the field in x and y, given in physical units
          * @param thickness_domain Domain in local coordinates in the thickness direction where the field holds
+         * @param reduced Axes in x and y along which the field has been collapsed to a single bin from a larger grid
+         * @param mirrored Axes in x and y along which only the upper half of the mirror-symmetric field is stored
          */
         void setGrid(std::shared_ptr<std::vector<double>> field,
                      std::array<size_t, 3> dimensions,
                      std::array<double, 2> scales,
                      std::array<double, 2> offset,
-                     std::pair<double, double> thickness_domain);
+                     std::pair<double, double> thickness_domain,
+                     std::array<bool, 2> reduced = {},
+                     std::array<bool, 2> mirrored = {});
         /**
          * @brief Set the field in the detector using a function
          * @param function Function used to calculate the field
@@ -157,10 +161,18 @@ namespace allpix {
          *   of the pixel pitch.
          * * Offset of the field from the pixel edge, e.g. when using fields centered at a pixel corner instead of the center
          *   Values provided as absolute shifts in um.
+         * * Axes along which the field has been reduced to a single bin because it is invariant in this direction. In
+         *   contrast to fields defined with a single bin, reduced fields remain limited to their original physical extent.
+         * * Axes along which the field is mirror-symmetric with respect to its center. Only the bins with positive
+         *   coordinates are stored and the vector components are flipped when looking up the other half.
+         * * Strides of the flat field vector in x and y, precalculated from the stored number of bins
          */
         std::array<size_t, 3> dimensions_{};
         std::array<double_t, 2> scales_{{1., 1.}};
         std::array<double_t, 2> offset_{{0., 0.}};
+        std::array<bool, 2> reduced_{};
+        std::array<bool, 2> mirrored_{};
+        std::array<size_t, 2> strides_{};
 
         /**
          * Field definition
@@ -173,6 +185,8 @@ namespace allpix {
          * component in the flat field vector can be calculated as:
          *
          *   field_i(x, y, z) =  x * Y_SIZE* Z_SIZE * N + y * Z_SIZE * + z * N + i
+         *
+         * For mirrored axes, X_SIZE and Y_SIZE denote the number of stored bins, i.e. the upper half of the full grid.
          */
         std::shared_ptr<std::vector<double>> field_;
         std::pair<double, double> thickness_domain_{};
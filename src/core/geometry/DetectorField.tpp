@@ -49,15 +49,27 @@ namespace allpix {
     // This means, {x,y,z} = (0,0,0) is in the center of the field.
     template <typename T, size_t N>
     T DetectorField<T, N>::get_field_from_grid(const ROOT::Math::XYZPoint& dist, const bool extrapolate_z) const {
+        // Fields reduced from a three-dimensional grid are only defined within their original extent:
+        if((reduced_[0] && std::fabs(dist.x()) > 0.5 * scales_[0] * pixel_size_.x()) ||
+           (reduced_[1] && std::fabs(dist.y()) > 0.5 * scales_[1] * pixel_size_.y())) {
+            return {};
+        }
+
+        // For mirrored fields, fold the position into the stored half or quadrant of the field:
+        auto flip_x = (mirrored_[0] && dist.x() < 0);
+        auto flip_y = (mirrored_[1] && dist.y() < 0);
+        auto x = (flip_x ? -dist.x() : dist.x());
+        auto y = (flip_y ? -dist.y() : dist.y());
+
         // Compute indices
         // If the number of bins in x or y is 1, the field is assumed to be 2-dimensional and the respective index
         // is forced to zero. This circumvents that the field size in the respective dimension would otherwise be zero
         auto x_ind = (dimensions_[0] == 1 ? 0
                                           : static_cast<int>(std::floor(static_cast<double>(dimensions_[0]) *
-                                                                        (dist.x() / (scales_[0] * pixel_size_.x()) + 0.5))));
+                                                                        (x / (scales_[0] * pixel_size_.x()) + 0.5))));
         auto y_ind = (dimensions_[1] == 1 ? 0
                                           : static_cast<int>(std::floor(static_cast<double>(dimensions_[1]) *
-                                                                        (dist.y() / (scales_[1] * pixel_size_.y()) + 0.5))));
+                                                                        (y / (scales_[1] * pixel_size_.y()) + 0.5))));
         auto z_ind = static_cast<int>(std::floor(static_cast<double>(dimensions_[2]) * (dist.z() - thickness_domain_.first) /
                                                  (thickness_domain_.second - thickness_domain_.first)));
 
@@ -74,11 +86,22 @@ namespace allpix {
             return {};
         }
 
+        // Mirrored fields only store the upper half of the bins along the respective axis:
+        if(mirrored_[0]) {
+            x_ind -= static_cast<int>(dimensions_[0] / 2);
+        }
+        if(mirrored_[1]) {
+            y_ind -= static_cast<int>(dimensions_[1] / 2);
+        }
+
         // Compute total index
-        size_t tot_ind = static_cast<size_t>(x_ind) * dimensions_[1] * dimensions_[2] * N +
-                         static_cast<size_t>(y_ind) * dimensions_[2] * N + static_cast<size_t>(z_ind) * N;
+        size_t tot_ind = static_cast<size_t>(x_ind) * strides_[0] + static_cast<size_t>(y_ind) * strides_[1] +
+                         static_cast<size_t>(z_ind) * N;
 
-        return get_impl(tot_ind, std::make_index_sequence<N>{});
+        // Restore the direction of the vector components along the mirrored axes:
+        auto ret_val = get_impl(tot_ind, std::make_index_sequence<N>{});
+        flip_vector_components(ret_val, flip_x, flip_y);
+        return ret_val;
     }
 
     /**
@@ -160,11 +183,17 @@ namespace allpix {
                                       std::array<size_t, 3> dimensions,
                                       std::array<double, 2> scales,
                                       std::array<double, 2> offset,
-                                      std::pair<double, double> thickness_domain) {
+                                      std::pair<double, double> thickness_domain,
+                                      std::array<bool, 2> reduced,
+                                      std::array<bool, 2> mirrored) {
         if(!model_initialized_) {
             throw std::invalid_argument("field not initialized with detector model parameters");
         }
-        if(dimensions[0] * dimensions[1] * dimensions[2] * N != field->size()) {
+
+        // Only the upper half of the bins is stored along mirrored axes:
+        std::array<size_t, 2> stored{{mirrored[0] ? dimensions[0] - dimensions[0] / 2 : dimensions[0],
+                                      mirrored[1] ? dimensions[1] - dimensions[1] / 2 : dimensions[1]}};
+        if(stored[0] * stored[1] * dimensions[2] * N != field->size()) {
             throw std::invalid_argument("field does not match the given dimensions");
         }
         if(thickness_domain.first + 1e-9 < sensor_center_.z() - sensor_size_.z() / 2.0 ||
@@ -174,11 +203,17 @@ namespace allpix {
         if(thickness_domain.first >= thickness_domain.second) {
             throw std::invalid_argument("end of thickness domain is before begin");
         }
+        if((reduced[0] && dimensions[0] != 1) || (reduced[1] && dimensions[1] != 1)) {
+            throw std::invalid_argument("reduced field axis has more than one bin");
+        }
 
         field_ = std::move(field);
         dimensions_ = dimensions;
         scales_ = scales;
         offset_ = offset;
+        reduced_ = reduced;
+        mirrored_ = mirrored;
+        strides_ = {{stored[1] * dimensions[2] * N, dimensions[2] * N}};
 
         thickness_domain_ = std::move(thickness_domain);
         type_ = FieldType::GRID;
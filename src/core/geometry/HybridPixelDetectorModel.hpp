@@ -30,6 +30,15 @@ namespace allpix {
      */
     class HybridPixelDetectorModel : public DetectorModel {
     public:
+        /**
+         * @brief Representation of the bump bonds in the geometry
+         */
+        enum class BumpGeometry {
+            PARAMETERISED = 0, ///< Individual bump bonds placed via a two-dimensional parameterisation
+            REPLICA,           ///< Individual bump bonds placed in pixel cells replicated along the x and y axes
+            LAYER,             ///< Homogeneous solder layer with the material budget of the bump bonds
+        };
+
         /**
          * @brief Constructs the hybrid pixel detector model
          * @param type Name of the model type
@@ -50,6 +59,7 @@ namespace allpix {
             setBumpCylinderRadius(config.get<double>("bump_cylinder_radius"));
             setBumpHeight(config.get<double>("bump_height"));
             setBumpSphereRadius(config.get<double>("bump_sphere_radius", 0));
+            setBumpGeometry(config.get<BumpGeometry>("bump_geometry", BumpGeometry::PARAMETERISED));
 
             auto pitch = config.get<ROOT::Math::XYVector>("pixel_size");
             auto bump_offset = config.get<ROOT::Math::XYVector>("bump_offset", {0, 0});
@@ -183,6 +193,16 @@ namespace allpix {
          * @param val Offset from the pixel grid center
          */
         void setBumpOffset(ROOT::Math::XYVector val) { bump_offset_ = std::move(val); }
+        /**
+         * @brief Get the representation of the bump bonds in the geometry
+         * @return Bump bond geometry
+         */
+        BumpGeometry getBumpGeometry() const { return bump_geometry_; }
+        /**
+         * @brief Set the representation of the bump bonds in the geometry
+         * @param val Bump bond geometry
+         */
+        void setBumpGeometry(BumpGeometry val) { bump_geometry_ = val; }
 
     private:
         std::array<double, 4> chip_excess_{};
@@ -191,6 +211,7 @@ namespace allpix {
         double bump_height_{};
         ROOT::Math::XYVector bump_offset_;
         double bump_cylinder_radius_{};
+        BumpGeometry bump_geometry_{BumpGeometry::PARAMETERISED};
     };
 } // namespace allpix
 
@@ -182,7 +182,7 @@ bool LocalMessenger::dispatchMessage(Module* source,
                     LOG(TRACE) << "Sending message " << allpix::demangle(type_idx.name()) << " from "
                                << source->getUniqueName() << " to " << delegate->getUniqueName();
                     // Construct BaseMessage where message should be stored
-                    auto& dest = messages_[delegate->getUniqueName()][type_idx];
+                    auto& dest = get_destination(delegate.get(), type_idx);
 
                     delegate->process(message, name, dest);
                     send = true;
@@ -201,7 +201,7 @@ bool LocalMessenger::dispatchMessage(Module* source,
                 if(check_send(message.get(), delegate.get())) {
                     LOG(TRACE) << "Sending message " << allpix::demangle(type_idx.name()) << " from "
                                << source->getUniqueName() << " to generic listener " << delegate->getUniqueName();
-                    auto& dest = messages_[delegate->getUniqueName()][typeid(BaseMessage)];
+                    auto& dest = get_destination(delegate.get(), typeid(BaseMessage));
                     delegate->process(message, name, dest);
                     send = true;
                 }
@@ -214,7 +214,38 @@ bool LocalMessenger::dispatchMessage(Module* source,
 
 std::vector<std::pair<std::shared_ptr<BaseMessage>, std::string>> LocalMessenger::fetchFilteredMessages(Module* module) {
     const std::type_index type_idx = typeid(BaseMessage);
-    return messages_.at(module->getUniqueName()).at(type_idx).filter_multi;
+    return get_messages(module, type_idx).filter_multi;
+}
+
+/**
+ * The messages of all modules are released, but the entries of the tables and the capacity of the containers are kept such
+ * that dispatching the messages of the next event does not need to allocate them again
+ */
+void LocalMessenger::clear() {
+    for(auto& module_messages : messages_) {
+        for(auto& type_messages : module_messages.second) {
+            auto& received_messages = type_messages.second;
+            received_messages.messages.single.reset();
+            received_messages.messages.multi.clear();
+            received_messages.messages.filter_multi.clear();
+            received_messages.received = false;
+        }
+    }
+    sent_messages_.clear();
+}
+
+const DelegateTypes& LocalMessenger::get_messages(Module* module, std::type_index type_idx) const {
+    const auto& received_messages = messages_.at(module->getUniqueName()).at(type_idx);
+    if(!received_messages.received) {
+        throw std::out_of_range("no messages received in this event");
+    }
+    return received_messages.messages;
+}
+
+DelegateTypes& LocalMessenger::get_destination(BaseDelegate* delegate, std::type_index type_idx) {
+    auto& received_messages = messages_[delegate->getUniqueName()][type_idx];
+    received_messages.received = true;
+    return received_messages.messages;
 }
 
 bool LocalMessenger::isSatisfied(BaseDelegate* delegate) const {
@@ -237,5 +268,5 @@ bool LocalMessenger::isSatisfied(BaseDelegate* delegate) const {
         return false;
     }
 
-    return true;
+    return iter->second.received;
 }
@@ -223,11 +223,43 @@ namespace allpix {
          */
         std::vector<std::pair<std::shared_ptr<BaseMessage>, std::string>> fetchFilteredMessages(Module* module);
 
+        /**
+         * @brief Release all messages while keeping the allocated tables and containers for the next event
+         */
+        void clear();
+
     private:
+        /**
+         * @brief Messages received by the delegates of a module for a message type
+         *
+         * The entries are kept when clearing the messenger, the received flag indicates if they belong to the current event
+         */
+        struct ReceivedMessages {
+            DelegateTypes messages;
+            bool received{false};
+        };
+
+        /**
+         * @brief Get the messages received by a module in the current event
+         * @param module Module to get the messages for
+         * @param type_idx Type of the messages
+         * @return Messages received by the module
+         * @throws std::out_of_range If no messages of this type were received by the module
+         */
+        const DelegateTypes& get_messages(Module* module, std::type_index type_idx) const;
+
+        /**
+         * @brief Get the destination for messages of a delegate, marking them as received in the current event
+         * @param delegate Delegate to get the destination for
+         * @param type_idx Type of the messages
+         * @return Destination for the messages
+         */
+        DelegateTypes& get_destination(BaseDelegate* delegate, std::type_index type_idx);
+
         // The global messenger which contains the shared delegate information
         const Messenger& global_messenger_;
 
-        std::unordered_map<std::string, std::unordered_map<std::type_index, DelegateTypes>> messages_;
+        std::unordered_map<std::string, std::unordered_map<std::type_index, ReceivedMessages>> messages_;
         std::vector<std::shared_ptr<BaseMessage>> sent_messages_;
     };
 } // namespace allpix
@@ -72,7 +72,7 @@ namespace allpix {
     template <typename T> std::shared_ptr<T> LocalMessenger::fetchMessage(Module* module) {
         static_assert(std::is_base_of<BaseMessage, T>::value, "Fetched message should inherit from Message class");
         std::type_index type_idx = typeid(T);
-        return std::static_pointer_cast<T>(messages_.at(module->getUniqueName()).at(type_idx).single);
+        return std::static_pointer_cast<T>(get_messages(module, type_idx).single);
     }
 
     template <typename T> std::vector<std::shared_ptr<T>> LocalMessenger::fetchMultiMessage(Module* module) {
@@ -81,8 +81,7 @@ namespace allpix {
         // TODO: do nothing if T == BaseMessage; there is no need to cast (optimized out)?
         std::type_index type_idx = typeid(T);
 
-        // Construct an empty vector in case no previous modules created one during dispatch
-        auto base_messages = messages_.at(module->getUniqueName()).at(type_idx).multi;
+        const auto& base_messages = get_messages(module, type_idx).multi;
 
         std::vector<std::shared_ptr<T>> derived_messages;
         derived_messages.reserve(base_messages.size());
@@ -29,6 +29,9 @@ Event::Event(Messenger& messenger, uint64_t event_num, uint64_t seed) : number(e
     local_messenger_ = std::make_unique<LocalMessenger>(messenger);
 }
 
+Event::Event(std::unique_ptr<LocalMessenger> local_messenger, uint64_t event_num, uint64_t seed)
+    : number(event_num), seed_(seed), local_messenger_(std::move(local_messenger)) {}
+
 void Event::set_and_seed_random_engine(RandomNumberGenerator* random_engine) {
     random_engine_ = random_engine;
     random_engine_->seed(seed_);
@@ -59,3 +62,36 @@ void Event::restore_random_engine_state() {
 LocalMessenger* Event::get_local_messenger() const {
     return local_messenger_.get();
 }
+
+EventPool::EventPool(Messenger& messenger) : messenger_(messenger) {}
+
+std::shared_ptr<Event> EventPool::get(uint64_t event_num, uint64_t seed) {
+    std::unique_lock<std::mutex> lock{mutex_};
+    if(local_messengers_.empty()) {
+        lock.unlock();
+        auto event = std::make_shared<Event>(messenger_, event_num, seed);
+        event->pool_ = this;
+        return event;
+    }
+
+    auto local_messenger = std::move(local_messengers_.back());
+    local_messengers_.pop_back();
+    lock.unlock();
+
+    // The constructor reusing a local messenger is private and thus not accessible to std::make_shared
+    std::shared_ptr<Event> event(new Event(std::move(local_messenger), event_num, seed));
+    event->pool_ = this;
+    return event;
+}
+
+/**
+ * The event itself may still be referenced by the task which finished it, only its local messenger is reused
+ */
+void EventPool::release(std::shared_ptr<Event> event) {
+    auto local_messenger = std::move(event->local_messenger_);
+    local_messenger->clear();
+
+    auto* pool = event->pool_;
+    std::lock_guard<std::mutex> lock{pool->mutex_};
+    pool->local_messengers_.push_back(std::move(local_messenger));
+}
@@ -26,6 +26,7 @@ namespace allpix {
     class Messenger;
     class BaseMessage;
     class LocalMessenger;
+    class EventPool;
 
     /**
      * @brief Holds the data required for running an event
@@ -34,6 +35,7 @@ namespace allpix {
         friend class ModuleManager;
         friend class Messenger;
         friend class SequentialModule;
+        friend class EventPool;
 
     public:
         /**
@@ -74,6 +76,14 @@ namespace allpix {
         uint64_t getRandomNumber() { return getRandomEngine()(); }
 
     private:
+        /**
+         * @brief Construct an Event with a local messenger reused from an earlier event
+         * @param local_messenger Local messenger without any messages
+         * @param event_num The unique event identifier
+         * @param seed Random generator seed for this event
+         */
+        Event(std::unique_ptr<LocalMessenger> local_messenger, uint64_t event_num, uint64_t seed);
+
         /**
          * @brief Sets the random engine and seed it to be used by this event
          * @param random_engine Pointer to RNG for this event
@@ -107,10 +117,53 @@ namespace allpix {
         // Local messenger used to dispatch messages in this event
         std::unique_ptr<LocalMessenger> local_messenger_;
 
+        // Pool which created this event and to which its local messenger is returned when finished
+        EventPool* pool_{nullptr};
+
         // Mutex for execution time
         static std::mutex stats_mutex_;
     };
 
+    /**
+     * @brief Pool of local messengers reused for subsequent events of a worker
+     *
+     * Every event is constructed anew, but takes its local messenger from the pool if one is available. When the event is
+     * finished, the pool releases the messages of its local messenger but keeps the tables and containers, such that the
+     * event processing does not need to allocate these structures again. Local messengers are returned to the pool which
+     * created the event, also if it is finished by another thread, such that a pool never holds more local messengers than
+     * its thread started events concurrently.
+     */
+    class EventPool {
+    public:
+        /**
+         * @brief Construct an empty pool
+         * @param messenger Messenger responsible for handling message transmission for the events
+         */
+        explicit EventPool(Messenger& messenger);
+
+        /**
+         * @brief Create a new event, reusing a pooled local messenger if available
+         * @param event_num The unique event identifier
+         * @param seed Random generator seed for this event
+         * @return Shared pointer to the event
+         */
+        std::shared_ptr<Event> get(uint64_t event_num, uint64_t seed);
+
+        /**
+         * @brief Return the local messenger of a finished event to the pool which created the event
+         * @param event Event to release the messages of, it cannot be used for dispatching messages afterwards
+         */
+        static void release(std::shared_ptr<Event> event);
+
+    private:
+        Messenger& messenger_;
+
+        // Local messengers are returned by the thread finishing their event, which is not necessarily the thread owning the
+        // pool
+        std::mutex mutex_;
+        std::vector<std::unique_ptr<LocalMessenger>> local_messengers_;
+    };
+
 } // namespace allpix
 
 #endif /* ALLPIX_MODULE_EVENT_H */
@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @brief Implementation of the periodic exporter of live run metrics
+ *
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "MetricsExporter.hpp"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "core/utils/exceptions.h"
+#include "core/utils/log.h"
+
+using namespace allpix;
+
+/**
+ * The metrics are written once before starting the background thread to report a file which cannot be written
+ */
+MetricsExporter::MetricsExporter(std::string file_name, std::chrono::nanoseconds interval, Collector collector)
+    : file_name_(std::move(file_name)), interval_(interval), collector_(std::move(collector)) {
+    if(!write()) {
+        throw RuntimeError("Cannot write metrics to file " + file_name_);
+    }
+
+    thread_ = std::thread([this]() {
+        bool failed = false;
+        std::unique_lock<std::mutex> lock{mutex_};
+        while(!stop_condition_.wait_for(lock, interval_, [this]() { return stop_; })) {
+            lock.unlock();
+            if(!write() && !failed) {
+                LOG(WARNING) << "Cannot write metrics to file " << file_name_ << ", skipping update";
+                failed = true;
+            }
+            lock.lock();
+        }
+    });
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+void MetricsExporter::stop() {
+    if(!thread_.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stop_ = true;
+    }
+    stop_condition_.notify_all();
+    thread_.join();
+    write();
+}
+
+std::string
+MetricsExporter::format(const std::string& name, const std::string& type, const std::string& help, double value) {
+    std::stringstream ss;
+    ss << std::setprecision(15);
+    ss << "# HELP " << name << " " << help << std::endl;
+    ss << "# TYPE " << name << " " << type << std::endl;
+    ss << name << " " << value << std::endl;
+    return ss.str();
+}
+
+/**
+ * The resident set size is read from the proc filesystem, which is only available on Linux
+ */
+uint64_t MetricsExporter::residentMemory() {
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0, resident = 0;
+    if(!(statm >> size >> resident)) {
+        return 0;
+    }
+    return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+}
+
+bool MetricsExporter::write() const {
+    auto temporary_name = file_name_ + ".tmp";
+    {
+        std::ofstream file(temporary_name, std::ios_base::out | std::ios_base::trunc);
+        if(!file) {
+            return false;
+        }
+        file << collector_();
+        if(!file) {
+            return false;
+        }
+    }
+    return std::rename(temporary_name.c_str(), file_name_.c_str()) == 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file
+ * @brief Definition of the periodic exporter of live run metrics
+ *
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_METRICS_EXPORTER_H
+#define ALLPIX_METRICS_EXPORTER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace allpix {
+    /**
+     * @brief Periodically writes metrics in the Prometheus text exposition format to a file
+     *
+     * A background thread calls the collector at a fixed interval and replaces the file with its output. The file is first
+     * written under a temporary name and then renamed, such that readers like the textfile collector of the Prometheus node
+     * exporter never see a partially written file. The metrics are written a last time when the exporter is stopped.
+     */
+    class MetricsExporter {
+    public:
+        /**
+         * @brief Function returning the current metrics in the Prometheus text exposition format
+         */
+        using Collector = std::function<std::string()>;
+
+        /**
+         * @brief Start exporting metrics
+         * @param file_name Path of the file to write the metrics to
+         * @param interval  Time between two updates of the file
+         * @param collector Function returning the current metrics
+         */
+        MetricsExporter(std::string file_name, std::chrono::nanoseconds interval, Collector collector);
+
+        /**
+         * @brief Stop exporting metrics if not done before
+         */
+        ~MetricsExporter();
+
+        /// @{
+        /**
+         * @brief Copying or moving the exporter is not allowed
+         */
+        MetricsExporter(const MetricsExporter&) = delete;
+        MetricsExporter& operator=(const MetricsExporter&) = delete;
+        MetricsExporter(MetricsExporter&&) = delete;
+        MetricsExporter& operator=(MetricsExporter&&) = delete;
+        /// @}
+
+        /**
+         * @brief Stop the background thread and write the final metrics
+         */
+        void stop();
+
+        /**
+         * @brief Format a single sample of a metric, including its help and type description
+         * @param name   Name of the metric
+         * @param type   Prometheus type of the metric, i.e. counter or gauge
+         * @param help   Description of the metric
+         * @param value  Current value of the metric
+         * @return Lines describing the metric
+         */
+        static std::string format(const std::string& name, const std::string& type, const std::string& help, double value);
+
+        /**
+         * @brief Get the resident set size of the current process
+         * @return Resident memory in bytes, zero if it cannot be determined
+         */
+        static uint64_t residentMemory();
+
+    private:
+        bool write() const;
+
+        std::string file_name_;
+        std::chrono::nanoseconds interval_;
+        Collector collector_;
+
+        std::mutex mutex_;
+        std::condition_variable stop_condition_;
+        bool stop_{false};
+        std::thread thread_;
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_METRICS_EXPORTER_H */
@@ -10,6 +10,7 @@
 
 #include "ModuleManager.hpp"
 #include "Event.hpp"
+#include "MetricsExporter.hpp"
 
 #include <dlfcn.h>
 #include <unistd.h>
@@ -19,9 +20,11 @@
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <limits>
 #include <random>
 #include <set>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 
@@ -34,6 +37,7 @@
 #include "core/geometry/GeometryManager.hpp"
 #include "core/messenger/Messenger.hpp"
 #include "core/utils/log.h"
+#include "core/utils/unit.h"
 
 // Common prefix for all modules
 // TODO [doc] Should be provided by the build system
@@ -63,6 +67,7 @@ void ModuleManager::load(Messenger* messenger, ConfigManager* conf_manager, Geom
 
     // Set default for performance plot creation:
     global_config.setDefault("performance_plots", false);
+    global_config.setDefault("performance_counters", false);
 
     // Store the messenger
     messenger_ = messenger;
@@ -564,6 +569,20 @@ void ModuleManager::initialize() {
         ThreadPool::registerThreadCount(threads_num);
     }
 
+    // Check the availability of hardware performance counters and prepare the sums for every module and thread
+    if(global_config.get<bool>("performance_counters")) {
+        PerformanceCounters counters;
+        if(counters.valid()) {
+            performance_counters_ = true;
+            for(auto& module : modules_) {
+                module_counters_[module.get()].resize(ThreadPool::threadCount());
+            }
+            LOG(STATUS) << "Collecting hardware performance counters for all module instantiations";
+        } else {
+            LOG(WARNING) << "Hardware performance counters are not available on this system, disabling their collection";
+        }
+    }
+
     auto start_time = std::chrono::steady_clock::now();
     LOG_PROGRESS(STATUS, "INIT_LOOP") << "Initializing " << modules_.size() << " module instantiations";
     for(auto& module : modules_) {
@@ -631,6 +650,12 @@ void ModuleManager::run(RandomNumberGenerator& seeder) {
     auto threads_num = global_config.get<unsigned int>("workers");
     size_t max_buffer_size = 1;
 
+    // Process the events in batches of consecutive events, each batch executed by a single task of the thread pool
+    auto event_batch_size = global_config.get<uint64_t>("event_batch_size", 1);
+    if(event_batch_size == 0) {
+        throw InvalidValueError(global_config, "event_batch_size", "batch size has to be larger than zero");
+    }
+
     // See if we can run in parallel with how many workers
     if(multithreading_flag_ && can_parallelize_) {
         LOG(STATUS) << "Multithreading enabled, processing events in parallel on " << threads_num << " worker threads";
@@ -641,6 +666,13 @@ void ModuleManager::run(RandomNumberGenerator& seeder) {
             throw InvalidValueError(global_config, "buffer_per_worker", "buffer per worker should be larger than one");
         }
         LOG(STATUS) << "Allocating a total of " << max_buffer_size << " event slots for buffered modules";
+
+        // Every event of a batch can occupy a buffer slot, hence a batch cannot exceed the buffer of a single worker
+        if(event_batch_size > max_buffer_size / threads_num) {
+            LOG(WARNING) << "Limiting event batch size to the buffer per worker of " << max_buffer_size / threads_num
+                         << " events";
+            event_batch_size = max_buffer_size / threads_num;
+        }
     } else {
         // Issue a warning in case MT was requested but we can't actually run in MT
         if(multithreading_flag_ && !can_parallelize_) {
@@ -705,10 +737,20 @@ void ModuleManager::run(RandomNumberGenerator& seeder) {
         }
     };
 
+    // Pools of local messengers reused by the events of every thread, destroyed only after the thread pool
+    std::vector<std::unique_ptr<EventPool>> event_pools;
+    for(unsigned int n = 0; n < ThreadPool::threadCount(); ++n) {
+        event_pools.push_back(std::make_unique<EventPool>(*messenger_));
+    }
+
     // Push 128 events for each worker to maintain enough work
     auto max_queue_size = threads_num * 128;
-    std::unique_ptr<ThreadPool> thread_pool =
-        std::make_unique<ThreadPool>(threads_num, max_queue_size, max_buffer_size, initialize_function, finalize_function);
+    std::unique_ptr<ThreadPool> thread_pool = std::make_unique<ThreadPool>(threads_num,
+                                                                           max_queue_size,
+                                                                           max_buffer_size,
+                                                                           static_cast<unsigned int>(event_batch_size),
+                                                                           initialize_function,
+                                                                           finalize_function);
 
     // Record the run stage total time
     auto start_time = std::chrono::steady_clock::now();
@@ -722,136 +764,277 @@ void ModuleManager::run(RandomNumberGenerator& seeder) {
     auto skip_events = global_config.get<uint64_t>("skip_events", 0);
     seeder.discard(skip_events);
 
+    // Exclude the first N finished events from the run time:
+    warmup_events_ = global_config.get<uint64_t>("warmup_events", 0);
+    auto warmup_time = start_time;
+
+    // Periodically export live metrics of the event loop, stopped before destroying the thread pool
+    std::unique_ptr<MetricsExporter> metrics_exporter;
+    if(global_config.has("metrics_file")) {
+        auto metrics_interval = global_config.get<double>("metrics_interval", Units::get(10.0, "s"));
+        if(metrics_interval <= 0) {
+            throw InvalidValueError(global_config, "metrics_interval", "interval has to be larger than zero");
+        }
+
+        export_metrics_ = true;
+        for(auto& module : modules_) {
+            module_metrics_time_[module.get()] = 0;
+        }
+
+        auto collector = [this,
+                          number_of_events,
+                          start_time,
+                          &finished_events,
+                          &thread_pool,
+                          last_time = start_time,
+                          last_events = uint64_t(0)]() mutable {
+            auto now = std::chrono::steady_clock::now();
+            uint64_t events = finished_events;
+            auto interval = static_cast<std::chrono::duration<double>>(now - last_time).count();
+            auto rate = (interval > 0 ? static_cast<double>(events - last_events) / interval : 0.);
+            last_time = now;
+            last_events = events;
+
+            std::stringstream ss;
+            ss << std::setprecision(15);
+            ss << MetricsExporter::format(
+                "allpix_events_finished_total", "counter", "Number of finished events", static_cast<double>(events));
+            ss << MetricsExporter::format("allpix_events_requested",
+                                          "gauge",
+                                          "Number of events requested for the run",
+                                          static_cast<double>(number_of_events));
+            ss << MetricsExporter::format(
+                "allpix_events_per_second", "gauge", "Events finished per second since the previous update", rate);
+            ss << MetricsExporter::format("allpix_events_buffered",
+                                          "gauge",
+                                          "Number of events buffered to be processed in order",
+                                          static_cast<double>(thread_pool->bufferedQueueSize()));
+            ss << MetricsExporter::format("allpix_events_queued",
+                                          "gauge",
+                                          "Number of tasks waiting in the queue of the thread pool",
+                                          static_cast<double>(thread_pool->queueSize()));
+            ss << MetricsExporter::format("allpix_run_time_seconds",
+                                          "gauge",
+                                          "Time since the start of the event loop",
+                                          static_cast<std::chrono::duration<double>>(now - start_time).count());
+            ss << MetricsExporter::format("allpix_resident_memory_bytes",
+                                          "gauge",
+                                          "Resident memory of the process",
+                                          static_cast<double>(MetricsExporter::residentMemory()));
+            ss << "# HELP allpix_module_time_seconds_total Time spent in the run method of a module" << std::endl;
+            ss << "# TYPE allpix_module_time_seconds_total counter" << std::endl;
+            for(auto& module : this->modules_) {
+                ss << "allpix_module_time_seconds_total{module=\"" << module->get_identifier().getUniqueName() << "\"} "
+                   << static_cast<double>(this->module_metrics_time_.at(module.get()).load()) / 1e9 << std::endl;
+            }
+            return ss.str();
+        };
+
+        // Relative paths are placed next to the main ROOT file
+        std::filesystem::path metrics_file = global_config.get<std::string>("metrics_file");
+        if(metrics_file.is_relative()) {
+            metrics_file = std::filesystem::path(gSystem->pwd()) / metrics_file;
+        }
+        try {
+            metrics_exporter = std::make_unique<MetricsExporter>(
+                metrics_file.string(), std::chrono::nanoseconds(static_cast<int64_t>(metrics_interval)), collector);
+        } catch(const RuntimeError& e) {
+            throw InvalidValueError(global_config, "metrics_file", e.what());
+        }
+        LOG(STATUS) << "Exporting live metrics to " << metrics_file.string();
+    }
+
     // Mark the first N events as completed for the thread pool. Since events start at one, always mark zero identifier as
     // completed
     for(size_t n = 0; n <= skip_events; n++) {
         thread_pool->markComplete(n);
     }
 
-    LOG(STATUS) << "Starting event loop";
-    for(uint64_t i = 1 + skip_events; i <= number_of_events + skip_events; i++) {
-        // Check if run was aborted and stop pushing extra events to the threadpool
-        if(terminate_) {
-            LOG(INFO) << "Interrupting event loop after " << i << " events because of request to terminate";
-            thread_pool->destroy();
-            global_config.set<uint64_t>("number_of_events", finished_events);
-            break;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstrict-overflow"
+    auto event_function_with_module = [this,
+                                       plot,
+                                       number_of_events,
+                                       skip_events,
+                                       &finished_events,
+                                       &warmup_time,
+                                       &thread_pool,
+                                       &event_pools](std::shared_ptr<Event> event,
+                                                     uint64_t event_num,
+                                                     uint64_t event_seed,
+                                                     ModuleList::iterator module_iter,
+                                                     long double event_time,
+                                                     auto&& self_func) mutable -> void {
+        // The RNG to be used by all events running on this thread
+        static thread_local RandomNumberGenerator random_engine;
+
+        // The hardware performance counters of this thread, opened on first use
+        static thread_local std::unique_ptr<PerformanceCounters> performance_counters;
+        if(this->performance_counters_ && performance_counters == nullptr) {
+            performance_counters = std::make_unique<PerformanceCounters>();
         }
 
-        // Get a new seed for the new event
-        uint64_t seed = seeder();
+        // Create the event data
+        if(event == nullptr) {
+            auto& event_pool = event_pools[std::min<size_t>(ThreadPool::threadNum(), event_pools.size() - 1)];
+            event = event_pool->get(event_num, event_seed);
+            event->set_and_seed_random_engine(&random_engine);
+            LOG(INFO) << "Starting event " << event_num << " with seed " << event_seed;
+        } else {
+            LOG(TRACE) << "Continue with earlier event, restoring random seed";
+            event->set_and_seed_random_engine(&random_engine);
+            event->restore_random_engine_state();
+        }
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wstrict-overflow"
-        auto event_function_with_module =
-            [this, plot, number_of_events, event_num = i, event_seed = seed, &finished_events, &thread_pool](
-                std::shared_ptr<Event> event,
-                ModuleList::iterator module_iter,
-                long double event_time,
-                auto&& self_func) mutable -> void {
-            // The RNG to be used by all events running on this thread
-            static thread_local RandomNumberGenerator random_engine;
-
-            // Create the event data
-            if(event == nullptr) {
-                event = std::make_shared<Event>(*this->messenger_, event_num, event_seed);
-                event->set_and_seed_random_engine(&random_engine);
-                LOG(INFO) << "Starting event " << event_num << " with seed " << event_seed;
-            } else {
-                LOG(TRACE) << "Continue with earlier event, restoring random seed";
-                event->set_and_seed_random_engine(&random_engine);
-                event->restore_random_engine_state();
-            }
+        while(module_iter != modules_.end()) {
+            auto module = *module_iter;
 
-            while(module_iter != modules_.end()) {
-                auto module = *module_iter;
+            LOG_PROGRESS(TRACE, "EVENT_LOOP")
+                << "Running event " << event->number << " [" << module->get_identifier().getUniqueName() << "]";
 
-                LOG_PROGRESS(TRACE, "EVENT_LOOP")
-                    << "Running event " << event->number << " [" << module->get_identifier().getUniqueName() << "]";
+            // Check if the module is satisfied to run
+            if(!module->check_delegates(this->messenger_, event.get())) {
+                LOG(TRACE) << "Not all required messages are received for " << module->get_identifier().getUniqueName()
+                           << ", skipping module!";
+                ++module_iter;
+                continue;
+            }
 
-                // Check if the module is satisfied to run
-                if(!module->check_delegates(this->messenger_, event.get())) {
-                    LOG(TRACE) << "Not all required messages are received for " << module->get_identifier().getUniqueName()
-                               << ", skipping module!";
-                    ++module_iter;
-                    continue;
-                }
+            // Get current time
+            auto start = std::chrono::steady_clock::now();
 
-                // Get current time
-                auto start = std::chrono::steady_clock::now();
+            // Set module specific logging settings
+            auto old_settings = ModuleManager::set_module_before(
+                module->get_identifier().getUniqueName(), module->get_configuration(), "R:", event->number);
 
-                // Set module specific logging settings
-                auto old_settings = ModuleManager::set_module_before(
-                    module->get_identifier().getUniqueName(), module->get_configuration(), "R:", event->number);
+            PerformanceCounters::Values counters_start{};
+            if(performance_counters != nullptr) {
+                counters_start = performance_counters->read();
+            }
 
-                // Run module
-                bool stop = false;
-                try {
-                    if(module->require_sequence() && event_num != thread_pool->minimumUncompleted()) {
-                        stop = true;
-                    } else {
-                        module->run(event.get());
-                    }
-                } catch(const MissingDependenciesException& e) {
+            // Run module
+            bool stop = false;
+            try {
+                if(module->require_sequence() && event_num != thread_pool->minimumUncompleted()) {
                     stop = true;
-                } catch(const EndOfRunException& e) {
-                    // Terminate if the module threw the EndOfRun request exception:
-                    LOG(WARNING) << "Request to terminate:" << std::endl << e.what();
-                    this->terminate_ = true;
+                } else {
+                    module->run(event.get());
                 }
+            } catch(const MissingDependenciesException& e) {
+                stop = true;
+            } catch(const EndOfRunException& e) {
+                // Terminate if the module threw the EndOfRun request exception:
+                LOG(WARNING) << "Request to terminate:" << std::endl << e.what();
+                this->terminate_ = true;
+            }
 
-                // Reset logging
-                ModuleManager::set_module_after(old_settings);
+            // Add the counted hardware events to the sums of this thread
+            if(performance_counters != nullptr) {
+                auto counters_end = performance_counters->read();
+                auto& thread_counters = this->module_counters_.at(module.get());
+                auto& counters = thread_counters[std::min<size_t>(ThreadPool::threadNum(), thread_counters.size() - 1)];
+                for(size_t counter = 0; counter < PerformanceCounters::NUM_COUNTERS; ++counter) {
+                    counters[counter] += counters_end[counter] - counters_start[counter];
+                }
+            }
 
-                // Update execution time
-                auto end = std::chrono::steady_clock::now();
-                std::lock_guard<std::mutex> stat_lock{event->stats_mutex_};
+            // Reset logging
+            ModuleManager::set_module_after(old_settings);
 
-                auto duration = static_cast<std::chrono::duration<long double>>(end - start).count();
-                event_time += duration;
-                this->module_execution_time_[module.get()] += duration;
+            // Update execution time
+            auto end = std::chrono::steady_clock::now();
+            std::lock_guard<std::mutex> stat_lock{event->stats_mutex_};
 
-                if(plot) {
-                    this->module_event_time_[module.get()]->Fill(static_cast<double>(duration));
-                }
+            auto duration = static_cast<std::chrono::duration<long double>>(end - start).count();
+            event_time += duration;
+            this->module_execution_time_[module.get()] += duration;
+            if(event_num <= skip_events + this->warmup_events_) {
+                this->module_warmup_time_[module.get()] += duration;
+            }
+            if(this->export_metrics_) {
+                this->module_metrics_time_.at(module.get()) +=
+                    static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            }
 
-                if(stop) {
-                    LOG(TRACE) << "Event " << event->number
-                               << " was interrupted because of missing dependencies, rescheduling...";
-                    // Store state of PRNG engine:
-                    event->store_random_engine_state();
-                    // Reschedule the event:
-                    auto event_function = std::bind(self_func, event, module_iter, event_time, self_func);
-                    auto future = thread_pool->submit(event->number, event_function, false);
-                    assert(future.valid() || !thread_pool->valid());
-                    auto buffered_events = thread_pool->bufferedQueueSize();
-                    LOG_PROGRESS(STATUS, "EVENT_LOOP") << "Buffered " << buffered_events << ", finished " << finished_events
-                                                       << " of " << number_of_events << " events";
-                    return;
-                }
+            if(plot) {
+                this->module_event_time_[module.get()]->Fill(static_cast<double>(duration));
+            }
 
-                ++module_iter;
+            if(stop) {
+                LOG(TRACE) << "Event " << event->number
+                           << " was interrupted because of missing dependencies, rescheduling...";
+                // Store state of PRNG engine:
+                event->store_random_engine_state();
+                // Reschedule the event:
+                auto event_function =
+                    std::bind(self_func, event, event_num, event_seed, module_iter, event_time, self_func);
+                auto future = thread_pool->submit(event->number, event_function, false);
+                assert(future.valid() || !thread_pool->valid());
+                auto buffered_events = thread_pool->bufferedQueueSize();
+                LOG_PROGRESS(STATUS, "EVENT_LOOP") << "Buffered " << buffered_events << ", finished " << finished_events
+                                                   << " of " << number_of_events << " events";
+                return;
             }
+
+            ++module_iter;
+        }
 #pragma GCC diagnostic pop
 
-            // All modules finished, mark as complete
-            thread_pool->markComplete(event->number);
+        // All modules finished, mark as complete
+        thread_pool->markComplete(event->number);
 
-            auto buffered_events = thread_pool->bufferedQueueSize();
-            if(plot) {
-                this->buffer_fill_level_->Fill(static_cast<double>(buffered_events));
-                event_time_->Fill(static_cast<double>(event_time));
-            }
+        // Release the messages and keep the local messenger for reuse by the thread which started the event
+        EventPool::release(std::move(event));
 
-            finished_events++;
-            LOG_PROGRESS(STATUS, "EVENT_LOOP") << "Buffered " << buffered_events << ", finished " << finished_events
-                                               << " of " << number_of_events << " events";
-        };
+        auto buffered_events = thread_pool->bufferedQueueSize();
+        if(plot) {
+            this->buffer_fill_level_->Fill(static_cast<double>(buffered_events));
+            event_time_->Fill(static_cast<double>(event_time));
+        }
+        this->buffer_fill_sum_ += buffered_events;
+        auto buffer_max = this->buffer_fill_max_.load();
+        while(buffered_events > buffer_max &&
+              !this->buffer_fill_max_.compare_exchange_weak(buffer_max, buffered_events)) {
+        }
+
+        // Only the thread finishing the last warm-up event sets its time, which is read after all workers are done
+        if(++finished_events == this->warmup_events_) {
+            warmup_time = std::chrono::steady_clock::now();
+        }
+        LOG_PROGRESS(STATUS, "EVENT_LOOP") << "Buffered " << buffered_events << ", finished " << finished_events
+                                           << " of " << number_of_events << " events";
+    };
+
+    LOG(STATUS) << "Starting event loop";
+    for(uint64_t i = 1 + skip_events; i <= number_of_events + skip_events; i += event_batch_size) {
+        // Check if run was aborted and stop pushing extra events to the threadpool
+        if(terminate_) {
+            LOG(INFO) << "Interrupting event loop after " << i << " events because of request to terminate";
+            thread_pool->destroy();
+            global_config.set<uint64_t>("number_of_events", finished_events);
+            break;
+        }
+
+        // Get new seeds for all events of the batch, in the same order as for single events
+        std::vector<uint64_t> seeds(std::min(event_batch_size, number_of_events + skip_events + 1 - i));
+        for(auto& seed : seeds) {
+            seed = seeder();
+        }
 
-        auto event_function =
-            std::bind(event_function_with_module, nullptr, modules_.begin(), 0, event_function_with_module);
+        auto batch_function =
+            [this, &thread_pool, event_function_with_module, first_event = i, seeds = std::move(seeds)]() mutable {
+                for(size_t n = 0; n < seeds.size(); ++n) {
+                    // Skip the remaining events after a request to terminate, completing them to not stall buffered events
+                    if(this->terminate_) {
+                        thread_pool->markComplete(first_event + n);
+                        continue;
+                    }
+                    event_function_with_module(
+                        nullptr, first_event + n, seeds[n], this->modules_.begin(), 0, event_function_with_module);
+                }
+            };
 
-        auto future = thread_pool->submit(event_function);
+        auto future = thread_pool->submit(batch_function);
         assert(future.valid() || !thread_pool->valid());
         thread_pool->checkException();
     }
@@ -864,10 +1047,26 @@ void ModuleManager::run(RandomNumberGenerator& seeder) {
     // Check exception for last events
     thread_pool->checkException();
 
+    // Write the final state of the metrics
+    if(metrics_exporter != nullptr) {
+        metrics_exporter->stop();
+    }
+
     LOG_PROGRESS(STATUS, "EVENT_LOOP") << "Finished run of " << finished_events << " events";
     auto end_time = std::chrono::steady_clock::now();
     total_time_ += static_cast<std::chrono::duration<long double>>(end_time - start_time).count();
 
+    // Store the statistics of the event loop
+    workers_ = threads_num;
+    finished_events_ = finished_events;
+    if(warmup_events_ > 0 && finished_events_ <= warmup_events_) {
+        LOG(WARNING) << "Run finished within the warm-up phase of " << warmup_events_
+                     << " events, including all events in the run time";
+        warmup_events_ = 0;
+    }
+    run_time_ = static_cast<std::chrono::duration<long double>>(end_time - (warmup_events_ > 0 ? warmup_time : start_time))
+                    .count();
+
     LOG(TRACE) << "Destroying thread pool";
 }
 
@@ -924,7 +1123,8 @@ void ModuleManager::finalize() {
 
     // Store performance plots
     Configuration& global_config = conf_manager_->getGlobalConfiguration();
-    if(global_config.get<bool>("performance_plots")) {
+    auto plot = global_config.get<bool>("performance_plots");
+    if(plot || performance_counters_) {
 
         auto* perf_dir = modules_file_->mkdir("performance");
         if(perf_dir == nullptr) {
@@ -932,8 +1132,10 @@ void ModuleManager::finalize() {
         }
         perf_dir->cd();
 
-        event_time_->Write();
-        buffer_fill_level_->Write();
+        if(plot) {
+            event_time_->Write();
+            buffer_fill_level_->Write();
+        }
 
         for(auto& module : modules_) {
             auto module_name = module->get_configuration().getName();
@@ -948,7 +1150,31 @@ void ModuleManager::finalize() {
             mod_dir->cd();
 
             // Write the histogram
-            module_event_time_[module.get()]->Write();
+            if(plot) {
+                module_event_time_[module.get()]->Write();
+            }
+
+            // Write the hardware counters, with one bin per thread and the main thread in the first bin
+            if(performance_counters_) {
+                auto identifier = module->get_identifier().getIdentifier();
+                auto name = (identifier.empty() ? module_name : identifier);
+                const auto& thread_counters = module_counters_[module.get()];
+                for(size_t counter = 0; counter < PerformanceCounters::NUM_COUNTERS; ++counter) {
+                    auto counter_name = PerformanceCounters::getName(counter);
+                    auto title = module_name + " " + counter_name + (!identifier.empty() ? " for " + identifier : "") +
+                                 ";thread;# " + counter_name;
+                    TH1D histogram((name + "_" + counter_name).c_str(),
+                                   title.c_str(),
+                                   static_cast<int>(thread_counters.size()),
+                                   -0.5,
+                                   static_cast<double>(thread_counters.size()) - 0.5);
+                    for(size_t thread = 0; thread < thread_counters.size(); ++thread) {
+                        histogram.SetBinContent(static_cast<int>(thread + 1),
+                                                static_cast<double>(thread_counters[thread][counter]));
+                    }
+                    histogram.Write();
+                }
+            }
         }
     }
 
@@ -1002,6 +1228,26 @@ void ModuleManager::finalize() {
     for(auto& module : modules_) {
         LOG(INFO) << " Module " << module->getUniqueName() << " took " << module_execution_time_[module.get()] << " seconds";
     }
+    if(performance_counters_) {
+        for(auto& module : modules_) {
+            PerformanceCounters::Values counters{};
+            for(const auto& thread_counters : module_counters_[module.get()]) {
+                for(size_t counter = 0; counter < PerformanceCounters::NUM_COUNTERS; ++counter) {
+                    counters[counter] += thread_counters[counter];
+                }
+            }
+            auto ratio = [](uint64_t numerator, uint64_t denominator) {
+                return denominator > 0 ? static_cast<double>(numerator) / static_cast<double>(denominator) : 0.;
+            };
+            auto cycles = counters[static_cast<size_t>(PerformanceCounters::Counter::CYCLES)];
+            auto instructions = counters[static_cast<size_t>(PerformanceCounters::Counter::INSTRUCTIONS)];
+            auto cache_misses = counters[static_cast<size_t>(PerformanceCounters::Counter::CACHE_MISSES)];
+            auto branch_misses = counters[static_cast<size_t>(PerformanceCounters::Counter::BRANCH_MISSES)];
+            LOG(INFO) << " Module " << module->getUniqueName() << " executed " << ratio(instructions, cycles)
+                      << " instructions per cycle with " << 1000 * ratio(cache_misses, instructions) << " cache misses and "
+                      << 1000 * ratio(branch_misses, instructions) << " branch misses per 1000 instructions";
+        }
+    }
 
     long double processing_time = 0;
     auto total_events = global_config.get<uint64_t>("number_of_events");
@@ -1017,6 +1263,36 @@ void ModuleManager::finalize() {
         LOG(STATUS) << "This corresponds to a processing time of \x1B[1m" << event_processing_time
                     << " ms/event\x1B[0m per worker";
     }
+
+    if(warmup_events_ > 0) {
+        LOG(STATUS) << "Excluding " << warmup_events_ << " warm-up events, events were processed at \x1B[1m"
+                    << std::round(static_cast<long double>(finished_events_ - warmup_events_) / run_time_) << " Hz\x1B[0m";
+    }
+}
+
+RunStatistics ModuleManager::getRunStatistics() const {
+    RunStatistics statistics;
+    statistics.workers = workers_;
+    statistics.events = finished_events_;
+    statistics.warmup_events = warmup_events_;
+    statistics.total_time = total_time_;
+    statistics.run_time = run_time_;
+    if(finished_events_ > 0) {
+        statistics.buffer_mean = static_cast<double>(buffer_fill_sum_) / static_cast<double>(finished_events_);
+    }
+    statistics.buffer_max = buffer_fill_max_;
+    for(const auto& module : modules_) {
+        auto time = module_execution_time_.find(module.get());
+        auto module_time = (time != module_execution_time_.end() ? time->second : 0.0l);
+
+        // Exclude the warm-up events unless the run finished within the warm-up phase
+        auto warmup_time = module_warmup_time_.find(module.get());
+        if(warmup_events_ > 0 && warmup_time != module_warmup_time_.end()) {
+            module_time -= warmup_time->second;
+        }
+        statistics.module_times.emplace_back(module->getUniqueName(), module_time);
+    }
+    return statistics;
 }
 
 /**
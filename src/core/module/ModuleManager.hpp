@@ -16,12 +16,16 @@
 #include <memory>
 #include <queue>
 #include <random>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <TDirectory.h>
 #include <TFile.h>
 #include <TH1D.h>
 
 #include "Module.hpp"
+#include "PerformanceCounters.hpp"
 #include "ThreadPool.hpp"
 #include "core/config/Configuration.hpp"
 #include "core/utils/log.h"
@@ -35,6 +39,21 @@ namespace allpix {
     class Messenger;
     class GeometryManager;
 
+    /**
+     * @brief Performance statistics of a run, complete after the modules have been finalized
+     */
+    struct RunStatistics {
+        unsigned int workers{};      ///< Number of worker threads, zero if multithreading is disabled
+        uint64_t events{};           ///< Number of finished events
+        uint64_t warmup_events{};    ///< Number of events at the start of the run excluded from the run time
+        long double total_time{};    ///< Total time spent in initialization, event processing and finalization
+        long double run_time{};      ///< Time spent processing the events after the warm-up phase
+        double buffer_mean{};        ///< Mean number of buffered events when finishing an event
+        size_t buffer_max{};         ///< Maximum number of buffered events when finishing an event
+        std::vector<std::pair<std::string, long double>> module_times; ///< Execution time of every module instantiation,
+                                                                       ///< excluding the events of the warm-up phase
+    };
+
     /**
      * @ingroup Managers
      * @brief Manager responsible for dynamically loading all modules and running their event sequence
@@ -108,6 +127,13 @@ namespace allpix {
          */
         void terminate();
 
+        /**
+         * @brief Get the performance statistics of the run
+         * @return Statistics of the run
+         * @warning Module execution times are only complete after the \ref ModuleManager::finalize "finalize function"
+         */
+        RunStatistics getRunStatistics() const;
+
     private:
         /**
          * @brief Create unique modules
@@ -158,12 +184,30 @@ namespace allpix {
         std::unique_ptr<TFile> modules_file_;
 
         std::map<Module*, long double> module_execution_time_;
+        // Part of the execution time of every module spent in the events of the warm-up phase
+        std::map<Module*, long double> module_warmup_time_;
         std::map<Module*, Histogram<TH1D>> module_event_time_;
         Histogram<TH1D> event_time_;
         Histogram<TH1D> buffer_fill_level_;
 
+        // Hardware performance counters of every module, summed separately for every thread
+        bool performance_counters_{false};
+        std::map<Module*, std::vector<PerformanceCounters::Values>> module_counters_;
+
+        // Cumulative run time of every module in nanoseconds, only summed if live metrics are exported
+        bool export_metrics_{false};
+        std::map<Module*, std::atomic<uint64_t>> module_metrics_time_;
+
         long double total_time_{};
 
+        // Statistics of the event loop
+        unsigned int workers_{};
+        uint64_t finished_events_{};
+        uint64_t warmup_events_{};
+        long double run_time_{};
+        std::atomic<uint64_t> buffer_fill_sum_{};
+        std::atomic<size_t> buffer_fill_max_{};
+
         std::map<std::string, void*> loaded_libraries_;
 
         std::atomic<bool> terminate_;
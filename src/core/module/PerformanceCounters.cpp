@@ -0,0 +1,109 @@
+/**
+ * @file
+ * @brief Implementation of hardware performance counters for the calling thread
+ *
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "PerformanceCounters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace allpix;
+
+#ifdef __linux__
+namespace {
+    /**
+     * @brief Open a single hardware counter for the calling thread in user space
+     * @param config   Hardware event to count
+     * @param group_fd File descriptor of the group leader, or -1 to open a new group
+     * @return File descriptor of the counter, negative if the counter is not available
+     */
+    int open_counter(uint64_t config, int group_fd) {
+        struct perf_event_attr attr {};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        // Only the group leader starts disabled, the group is enabled at once after opening all counters:
+        if(group_fd < 0) {
+            attr.disabled = 1;
+        }
+        return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+    }
+} // namespace
+#endif
+
+PerformanceCounters::PerformanceCounters() {
+    fds_.fill(-1);
+    positions_.fill(NUM_COUNTERS);
+#ifdef __linux__
+    const std::array<uint64_t, NUM_COUNTERS> configs{
+        {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES}};
+
+    // The cycle counter leads the group, all other counters are optional:
+    for(size_t counter = 0; counter < NUM_COUNTERS; ++counter) {
+        fds_[counter] = open_counter(configs[counter], group_fd_);
+        if(fds_[counter] < 0) {
+            if(counter == 0) {
+                return;
+            }
+            continue;
+        }
+        if(counter == 0) {
+            group_fd_ = fds_[counter];
+        }
+        positions_[counter] = num_open_++;
+    }
+
+    ioctl(group_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+PerformanceCounters::~PerformanceCounters() {
+#ifdef __linux__
+    for(auto fd : fds_) {
+        if(fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+PerformanceCounters::Values PerformanceCounters::read() const {
+    Values values{};
+#ifdef __linux__
+    if(group_fd_ < 0) {
+        return values;
+    }
+
+    // Group read format: number of counters followed by their values in the order of opening
+    std::array<uint64_t, NUM_COUNTERS + 1> buffer{};
+    auto size = static_cast<ssize_t>(sizeof(uint64_t) * (num_open_ + 1));
+    if(::read(group_fd_, buffer.data(), static_cast<size_t>(size)) != size) {
+        return values;
+    }
+    for(size_t counter = 0; counter < NUM_COUNTERS; ++counter) {
+        if(positions_[counter] < num_open_) {
+            values[counter] = buffer[positions_[counter] + 1];
+        }
+    }
+#endif
+    return values;
+}
+
+std::string PerformanceCounters::getName(size_t counter) {
+    static const std::array<std::string, NUM_COUNTERS> names{{"cycles", "instructions", "cache_misses", "branch_misses"}};
+    return names.at(counter);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file
+ * @brief Definition of hardware performance counters for the calling thread
+ *
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_PERFORMANCE_COUNTERS_H
+#define ALLPIX_PERFORMANCE_COUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace allpix {
+    /**
+     * @brief Group of hardware performance counters measuring the calling thread
+     *
+     * The counters are opened via the perf_event_open system call of the Linux kernel and only count events in user space.
+     * If the system call is not available, e.g. on other operating systems, in containers without the required permission
+     * or on virtual machines without access to the performance monitoring unit, the counters are invalid and all reads
+     * return zero. Single counters not supported by the hardware are skipped and always read as zero.
+     */
+    class PerformanceCounters {
+    public:
+        /**
+         * @brief Events counted
+         */
+        enum class Counter : size_t {
+            CYCLES = 0,    ///< CPU cycles
+            INSTRUCTIONS,  ///< Retired instructions
+            CACHE_MISSES,  ///< Last level cache misses
+            BRANCH_MISSES, ///< Mispredicted branches
+        };
+        static constexpr size_t NUM_COUNTERS = 4;
+        using Values = std::array<uint64_t, NUM_COUNTERS>;
+
+        /**
+         * @brief Open and start the counters for the calling thread
+         */
+        PerformanceCounters();
+
+        /**
+         * @brief Close the counters
+         */
+        ~PerformanceCounters();
+
+        /// @{
+        /**
+         * @brief Copying or moving the counters is not allowed
+         */
+        PerformanceCounters(const PerformanceCounters&) = delete;
+        PerformanceCounters& operator=(const PerformanceCounters&) = delete;
+        PerformanceCounters(PerformanceCounters&&) = delete;
+        PerformanceCounters& operator=(PerformanceCounters&&) = delete;
+        /// @}
+
+        /**
+         * @brief Check if the counters could be opened
+         * @return True if at least the cycle counter is available, false otherwise
+         */
+        bool valid() const { return group_fd_ >= 0; }
+
+        /**
+         * @brief Read the current values of all counters
+         * @return Counter values since opening the counters
+         * @warning Should only be called from the thread which opened the counters
+         */
+        Values read() const;
+
+        /**
+         * @brief Get the name of a counter
+         * @param counter Counter index
+         * @return Lower-case name of the counter
+         */
+        static std::string getName(size_t counter);
+
+    private:
+        int group_fd_{-1};
+        std::array<int, NUM_COUNTERS> fds_{};
+
+        // Position of every counter in the group read, or the number of counters if not available
+        std::array<size_t, NUM_COUNTERS> positions_{};
+        size_t num_open_{};
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_PERFORMANCE_COUNTERS_H */
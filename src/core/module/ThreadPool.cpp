@@ -27,23 +27,27 @@ ThreadPool::ThreadPool(unsigned int num_threads,
                        unsigned int max_queue_size,
                        const std::function<void()>& worker_init_function,
                        const std::function<void()>& worker_finalize_function)
-    : ThreadPool(num_threads, max_queue_size, 0, worker_init_function, worker_finalize_function) {
+    : ThreadPool(num_threads, max_queue_size, 0, 0, worker_init_function, worker_finalize_function) {
     with_buffered_ = false;
 }
 
+/**
+ * Standard jobs are only started if the buffered queue can take all jobs the running standard jobs could still submit
+ */
 ThreadPool::ThreadPool(unsigned int num_threads,
                        unsigned int max_queue_size,
                        unsigned int max_buffered_size,
+                       unsigned int max_buffered_per_job,
                        const std::function<void()>& worker_init_function,
                        const std::function<void()>& worker_finalize_function)
     : queue_(max_queue_size, max_buffered_size) {
-    assert(max_buffered_size == 0 || max_buffered_size >= num_threads);
+    assert(max_buffered_size == 0 || max_buffered_size >= num_threads * max_buffered_per_job);
     // Create threads
     try {
         for(unsigned int i = 0u; i < num_threads; ++i) {
             threads_.emplace_back(&ThreadPool::worker,
                                   this,
-                                  std::min(num_threads, max_buffered_size),
+                                  std::min(num_threads * max_buffered_per_job, max_buffered_size),
                                   worker_init_function,
                                   worker_finalize_function);
         }
@@ -150,7 +150,9 @@ namespace allpix {
          * @brief Construct thread pool with provided number of threads with buffered jobs
          * @param num_threads Number of threads in the pool
          * @param max_queue_size Maximum size of the standard job queue
-         * @param max_buffered_size Maximum size of the buffered job queue (should be at least number of threads)
+         * @param max_buffered_size Maximum size of the buffered job queue (should be at least number of threads times the
+         *                          number of buffered jobs per standard job)
+         * @param max_buffered_per_job Maximum number of buffered jobs a single standard job can submit
          * @param worker_init_function Function run by all the workers to initialize
          * @param worker_finalize_function Function run by all the workers to cleanup
          * @warning Total count of threads need to be preregistered via \ref ThreadPool::registerThreadCount
@@ -158,6 +160,7 @@ namespace allpix {
         ThreadPool(unsigned int num_threads,
                    unsigned int max_queue_size,
                    unsigned int max_buffered_size,
+                   unsigned int max_buffered_per_job,
                    const std::function<void()>& worker_init_function = nullptr,
                    const std::function<void()>& worker_finalize_function = nullptr);
 
@@ -8,13 +8,23 @@
  * Intergovernmental Organization or submit itself to any jurisdiction.
  */
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <cerrno>
 #include <csignal>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #include <boost/version.hpp>
 
@@ -23,6 +33,7 @@
 #include "core/geometry/GeometryManager.hpp"
 #include "core/utils/exceptions.h"
 #include "core/utils/log.h"
+#include "core/utils/text.h"
 
 #ifdef ALLPIX_GEANT4_AVAILABLE
 #include <G4Version.hh>
@@ -33,6 +44,17 @@ using namespace allpix;
 void clean();
 void abort_handler(int);
 void interrupt_handler(int);
+std::string json_string(const std::string& str);
+std::string benchmark_entry(const RunStatistics& statistics);
+int run_framework(const std::string& config_file_name,
+                  const std::vector<std::string>& module_options,
+                  const std::vector<std::string>& detector_options,
+                  RunStatistics* statistics = nullptr);
+int run_benchmark(const std::string& config_file_name,
+                  const std::vector<std::string>& module_options,
+                  const std::vector<std::string>& detector_options,
+                  const std::vector<unsigned int>& workers,
+                  const std::string& report_file_name);
 
 std::unique_ptr<Allpix> apx;
 std::atomic<bool> apx_ready{false};
@@ -72,6 +94,237 @@ void clean() {
     }
 }
 
+/**
+ * @brief Quote a string for a JSON document
+ */
+std::string json_string(const std::string& str) {
+    std::string quoted = "\"";
+    for(auto character : str) {
+        if(character == '"' || character == '\\') {
+            quoted += '\\';
+        }
+        quoted += character;
+    }
+    return quoted + "\"";
+}
+
+/**
+ * @brief Create the JSON report entry of a single benchmark run
+ * @param statistics Statistics of the run
+ * @return JSON object describing the run
+ */
+std::string benchmark_entry(const RunStatistics& statistics) {
+    // Peak resident set size of this process, reported in kilobytes on Linux and in bytes on macOS
+    struct rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    auto peak_rss = static_cast<long>(usage.ru_maxrss / 1024);
+#else
+    auto peak_rss = static_cast<long>(usage.ru_maxrss);
+#endif
+
+    long double module_time = 0;
+    for(const auto& [name, time] : statistics.module_times) {
+        module_time += time;
+    }
+
+    std::stringstream entry;
+    auto measured_events = statistics.events - statistics.warmup_events;
+    entry << "    {" << std::endl;
+    entry << "      \"workers\": " << statistics.workers << "," << std::endl;
+    entry << "      \"events\": " << statistics.events << "," << std::endl;
+    entry << "      \"warmup_events\": " << statistics.warmup_events << "," << std::endl;
+    entry << "      \"total_time\": " << statistics.total_time << "," << std::endl;
+    entry << "      \"run_time\": " << statistics.run_time << "," << std::endl;
+    entry << "      \"events_per_second\": "
+          << (statistics.run_time > 0 ? static_cast<long double>(measured_events) / statistics.run_time : 0) << ","
+          << std::endl;
+    entry << "      \"buffer_mean\": " << statistics.buffer_mean << "," << std::endl;
+    entry << "      \"buffer_max\": " << statistics.buffer_max << "," << std::endl;
+    entry << "      \"peak_rss_kb\": " << peak_rss << "," << std::endl;
+    entry << "      \"modules\": [";
+    for(size_t i = 0; i < statistics.module_times.size(); ++i) {
+        const auto& [name, time] = statistics.module_times[i];
+        entry << (i == 0 ? "" : ",") << std::endl
+              << "        {\"name\": " << json_string(name) << ", \"time\": " << time
+              << ", \"share\": " << (module_time > 0 ? time / module_time : 0) << "}";
+    }
+    entry << std::endl << "      ]" << std::endl << "    }";
+    return entry.str();
+}
+
+/**
+ * @brief Construct the framework and process a full run
+ * @param config_file_name Path of the main configuration file
+ * @param module_options List of extra configuration options for modules
+ * @param detector_options List of extra configuration options for the geometry setup
+ * @param statistics Optional pointer to store the performance statistics of the run
+ * @return Return code of the executable
+ */
+int run_framework(const std::string& config_file_name,
+                  const std::vector<std::string>& module_options,
+                  const std::vector<std::string>& detector_options,
+                  RunStatistics* statistics) {
+    int return_code = 0;
+    try {
+        // Construct main Allpix object
+        apx = std::make_unique<Allpix>(config_file_name, module_options, detector_options);
+        apx_ready = true;
+
+        // Load modules
+        apx->load();
+
+        // Initialize modules (pre-run)
+        apx->initialize();
+
+        // Run modules and event-loop
+        apx->run();
+
+        // Finalize modules (post-run)
+        apx->finalize();
+
+        if(statistics != nullptr) {
+            *statistics = apx->getRunStatistics();
+        }
+    } catch(ConfigurationError& e) {
+        LOG(FATAL) << "Error in the configuration:" << std::endl
+                   << e.what() << std::endl
+                   << "The configuration needs to be updated. Cannot continue.";
+        return_code = 1;
+    } catch(RuntimeError& e) {
+        LOG(FATAL) << "Error during execution of run:" << std::endl
+                   << e.what() << std::endl
+                   << "Please check your configuration and modules. Cannot continue.";
+        return_code = 1;
+    } catch(LogicError& e) {
+        LOG(FATAL) << "Error in the logic of module:" << std::endl
+                   << e.what() << std::endl
+                   << "Module has to be properly defined. Cannot continue.";
+        return_code = 1;
+    } catch(std::exception& e) {
+        LOG(FATAL) << "Fatal internal error" << std::endl << e.what() << std::endl << "Cannot continue.";
+        return_code = 127;
+    }
+
+    return return_code;
+}
+
+/**
+ * @brief Run the configuration once for every number of workers and write a report of the performance
+ * @param config_file_name Path of the main configuration file
+ * @param module_options List of extra configuration options for modules
+ * @param detector_options List of extra configuration options for the geometry setup
+ * @param workers List of numbers of workers, zero disabling multithreading
+ * @param report_file_name Path of the JSON report to be written
+ * @return Return code of the executable
+ *
+ * Every run is executed in a separate process, such that all runs start from a clean state and the peak memory usage can
+ * be determined per run. Unless set in the configuration file or the module options, the random seed is fixed to make all
+ * runs process identical events.
+ */
+int run_benchmark(const std::string& config_file_name,
+                  const std::vector<std::string>& module_options,
+                  const std::vector<std::string>& detector_options,
+                  const std::vector<unsigned int>& workers,
+                  const std::string& report_file_name) {
+    // Check if the random seed is set in the configuration file or by the module options
+    bool seeded = false;
+    try {
+        ConfigManager config_manager(config_file_name,
+                                     std::initializer_list<std::string>({"Allpix", ""}),
+                                     std::initializer_list<std::string>({"Ignore"}));
+        config_manager.loadModuleOptions(module_options);
+        seeded = config_manager.getGlobalConfiguration().has("random_seed");
+    } catch(ConfigurationError& e) {
+        LOG(FATAL) << "Error in the configuration:" << std::endl
+                   << e.what() << std::endl
+                   << "The configuration needs to be updated. Cannot continue.";
+        return 1;
+    }
+
+    int return_code = 0;
+    std::vector<std::string> entries;
+    for(auto worker_count : workers) {
+        auto options = module_options;
+        if(!seeded) {
+            options.insert(options.begin(), "random_seed=1");
+        }
+        options.emplace_back(worker_count > 0 ? "multithreading=true" : "multithreading=false");
+        if(worker_count > 0) {
+            options.emplace_back("workers=" + std::to_string(worker_count));
+        }
+        LOG(STATUS) << "Benchmarking configuration with " << worker_count << " workers";
+
+        // Run the framework in a child process which reports its statistics through a pipe:
+        std::array<int, 2> pipe_fds{};
+        if(pipe(pipe_fds.data()) != 0) {
+            LOG(FATAL) << "Cannot create pipe for benchmark run: " << std::strerror(errno);
+            return 1;
+        }
+        std::cout.flush();
+        auto pid = fork();
+        if(pid < 0) {
+            LOG(FATAL) << "Cannot create process for benchmark run: " << std::strerror(errno);
+            return 1;
+        }
+        if(pid == 0) {
+            close(pipe_fds[0]);
+            RunStatistics statistics;
+            auto code = run_framework(config_file_name, options, detector_options, &statistics);
+            if(code == 0) {
+                auto entry = benchmark_entry(statistics);
+                for(size_t written = 0; written < entry.size();) {
+                    auto count = write(pipe_fds[1], entry.data() + written, entry.size() - written);
+                    if(count <= 0) {
+                        break;
+                    }
+                    written += static_cast<size_t>(count);
+                }
+            }
+            close(pipe_fds[1]);
+            clean();
+            std::cout.flush();
+            _exit(code);
+        }
+
+        close(pipe_fds[1]);
+        std::string entry;
+        std::array<char, 4096> buffer{};
+        ssize_t count = 0;
+        while((count = read(pipe_fds[0], buffer.data(), buffer.size())) > 0) {
+            entry.append(buffer.data(), static_cast<size_t>(count));
+        }
+        close(pipe_fds[0]);
+
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != 0 || entry.empty()) {
+            LOG(ERROR) << "Benchmark run with " << worker_count << " workers failed";
+            return_code = 1;
+            continue;
+        }
+        entries.push_back(entry);
+    }
+
+    // Write the report
+    std::ofstream report_file(report_file_name);
+    if(!report_file.good()) {
+        LOG(FATAL) << "Cannot write benchmark report to " << report_file_name;
+        return 1;
+    }
+    report_file << "{" << std::endl;
+    report_file << "  \"version\": \"" << ALLPIX_PROJECT_VERSION << "\"," << std::endl;
+    report_file << "  \"config\": " << json_string(config_file_name) << "," << std::endl;
+    report_file << "  \"runs\": [";
+    for(size_t i = 0; i < entries.size(); ++i) {
+        report_file << (i == 0 ? "" : ",") << std::endl << entries[i];
+    }
+    report_file << std::endl << "  ]" << std::endl << "}" << std::endl;
+    LOG(STATUS) << "Wrote benchmark report for " << entries.size() << " runs to " << report_file_name;
+
+    return return_code;
+}
+
 /**
  * @brief Main function running the application
  */
@@ -102,6 +355,8 @@ int main(int argc, const char* argv[]) {
     std::string log_file_name;
     std::vector<std::string> module_options;
     std::vector<std::string> detector_options;
+    std::vector<unsigned int> benchmark_workers;
+    std::string benchmark_report = "benchmark.json";
 
     for(int i = 1; i < argc; i++) {
         std::string arg = argv[i];
@@ -153,6 +408,23 @@ int main(int argc, const char* argv[]) {
             }
         } else if(arg == "-g" && (i + 1 < argc)) {
             detector_options.emplace_back(std::string(argv[++i]));
+        } else if(arg == "--benchmark" && (i + 1 < argc)) {
+            try {
+                benchmark_workers = split<unsigned int>(std::string(argv[++i]), ",");
+            } catch(std::invalid_argument& e) {
+                LOG(ERROR) << "Invalid list of workers \"" << std::string(argv[i]) << "\" for benchmark";
+                print_help = true;
+                return_code = 1;
+            }
+            // Multithreading requires more than one worker, a single thread is benchmarked with zero workers
+            if(std::find(benchmark_workers.begin(), benchmark_workers.end(), 1u) != benchmark_workers.end()) {
+                LOG(ERROR) << "Invalid number of workers 1 for benchmark, multithreading requires at least two workers, "
+                              "use 0 to benchmark without multithreading";
+                print_help = true;
+                return_code = 1;
+            }
+        } else if(arg == "--benchmark-report" && (i + 1 < argc)) {
+            benchmark_report = std::string(argv[++i]);
         } else {
             LOG(ERROR) << "Unrecognized command line argument \"" << argv[i] << "\"";
             print_help = true;
@@ -176,6 +448,12 @@ int main(int argc, const char* argv[]) {
         std::cout << "  -j <workers> number of worker threads, equivalent to" << std::endl;
         std::cout << "               -o multithreading=true -o workers=<workers>" << std::endl;
         std::cout << "  --version    print version information and quit" << std::endl;
+        std::cout << "  --benchmark <workers>" << std::endl;
+        std::cout << "               run the configuration once for each number of workers in the" << std::endl;
+        std::cout << "               comma-separated list, 0 disabling multithreading, otherwise" << std::endl;
+        std::cout << "               at least 2 workers are required" << std::endl;
+        std::cout << "  --benchmark-report <file>" << std::endl;
+        std::cout << "               file to write the benchmark report to, defaults to benchmark.json" << std::endl;
         std::cout << std::endl;
         std::cout << "For more help, please see <https://cern.ch/allpix-squared>" << std::endl;
         clean();
@@ -203,40 +481,10 @@ int main(int argc, const char* argv[]) {
         Log::addStream(log_file);
     }
 
-    try {
-        // Construct main Allpix object
-        apx = std::make_unique<Allpix>(config_file_name, module_options, detector_options);
-        apx_ready = true;
-
-        // Load modules
-        apx->load();
-
-        // Initialize modules (pre-run)
-        apx->initialize();
-
-        // Run modules and event-loop
-        apx->run();
-
-        // Finalize modules (post-run)
-        apx->finalize();
-    } catch(ConfigurationError& e) {
-        LOG(FATAL) << "Error in the configuration:" << std::endl
-                   << e.what() << std::endl
-                   << "The configuration needs to be updated. Cannot continue.";
-        return_code = 1;
-    } catch(RuntimeError& e) {
-        LOG(FATAL) << "Error during execution of run:" << std::endl
-                   << e.what() << std::endl
-                   << "Please check your configuration and modules. Cannot continue.";
-        return_code = 1;
-    } catch(LogicError& e) {
-        LOG(FATAL) << "Error in the logic of module:" << std::endl
-                   << e.what() << std::endl
-                   << "Module has to be properly defined. Cannot continue.";
-        return_code = 1;
-    } catch(std::exception& e) {
-        LOG(FATAL) << "Fatal internal error" << std::endl << e.what() << std::endl << "Cannot continue.";
-        return_code = 127;
+    if(benchmark_workers.empty()) {
+        return_code = run_framework(config_file_name, module_options, detector_options);
+    } else {
+        return_code = run_benchmark(config_file_name, module_options, detector_options, benchmark_workers, benchmark_report);
     }
 
     // Finish the logging
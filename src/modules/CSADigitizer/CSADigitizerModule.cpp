@@ -12,6 +12,7 @@
 #include "core/utils/distributions.h"
 #include "core/utils/unit.h"
 #include "tools/ROOT.h"
+#include "tools/pulse_convolution.h"
 
 #include <TF1.h>
 #include <TFile.h>
@@ -221,7 +222,7 @@ void CSADigitizerModule::run(Event* event) {
             throw ModuleError("No pulse information available.");
         }
 
-        auto pulse_vec = pulse.getPulse(); // the vector of the charges
+        const auto& pulse_vec = pulse.getPulse(); // the vector of the charges
         auto timestep = pulse.getBinning();
         LOG(DEBUG) << "Timestep: " << timestep << " integration_time: " << integration_time_;
         auto ntimepoints = static_cast<size_t>(ceil(integration_time_ / timestep));
@@ -255,22 +256,10 @@ void CSADigitizerModule::run(Event* event) {
         });
 
         std::vector<double> amplified_pulse_vec(ntimepoints);
-        auto input_length = pulse_vec.size();
         LOG(TRACE) << "Preparing pulse for pixel " << pixel_index << ", " << pulse_vec.size() << " bins of "
                    << Units::display(timestep, {"ps", "ns"}) << ", total charge: " << Units::display(pulse.getCharge(), "e");
-        // convolution of the pulse (size input_length) with the impulse response (size ntimepoints)
-        for(size_t k = 0; k < ntimepoints; ++k) {
-            double outsum{};
-            // convolution: multiply pulse_vec.at(k - i) * impulse_response_function_.at(i), when (k - i) < input_length
-            // -> no point to start i at 0, start from jmin:
-            size_t jmin = (k >= input_length - 1) ? k - (input_length - 1) : 0;
-            for(size_t i = jmin; i <= k; ++i) {
-                if((k - i) < input_length) {
-                    outsum += pulse_vec.at(k - i) * impulse_response_function_.at(i);
-                }
-            }
-            amplified_pulse_vec.at(k) = outsum;
-        }
+        // convolution of the pulse with the impulse response (size ntimepoints)
+        convolve_pulse(pulse_vec, impulse_response_function_, amplified_pulse_vec);
 
         if(output_pulsegraphs_) {
             // Fill a graph with the pulse:
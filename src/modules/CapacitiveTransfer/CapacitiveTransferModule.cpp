@@ -256,15 +256,45 @@ void CapacitiveTransferModule::initialize() {
             "Capacitive coupling was not defined. Please, check the README file for configuration options or use "
             "the SimpleTransfer module.");
     }
+
+    // Store the coupling matrix as sparse kernel, only keeping the central pixel if cross-coupling is disabled:
+    coupling_scan_ = config_.has("coupling_scan_file");
+    for(size_t row = 0; row < matrix_rows_; row++) {
+        for(size_t col = 0; col < matrix_cols_; col++) {
+            auto dx = static_cast<int>(col) - static_cast<int>(matrix_cols_ / 2);
+            auto dy = static_cast<int>(row) - static_cast<int>(matrix_rows_ / 2);
+            if(!cross_coupling_ && (dx != 0 || dy != 0)) {
+                continue;
+            }
+
+            // The coupling of scanned capacitances depends on the gap at the receiving pixel and is evaluated per event:
+            double factor = 0;
+            if(config_.has("coupling_file")) {
+                factor = relative_coupling_[col][row];
+            } else if(config_.has("coupling_matrix")) {
+                factor = relative_coupling_[matrix_rows_ - row - 1][col];
+            }
+            if(!coupling_scan_ && std::fabs(factor) < std::numeric_limits<double>::epsilon()) {
+                continue;
+            }
+            coupling_kernel_.push_back({dx, dy, row * matrix_cols_ + col, factor});
+        }
+    }
+    LOG(DEBUG) << "Coupling kernel has " << coupling_kernel_.size() << " non-zero entries";
+
+    // Prepare one set of pixel maps for every thread that can run events
+    collected_maps_.resize(ThreadPool::threadCount());
+    pixel_maps_.resize(ThreadPool::threadCount());
 }
 
 void CapacitiveTransferModule::run(Event* event) {
     auto propagated_message = messenger_->fetchMessage<PropagatedChargeMessage>(this, event);
 
-    // Find corresponding pixels for all propagated charges
+    // Sum the charges collected at each pixel before applying the coupling
     LOG(TRACE) << "Transferring charges to pixels";
-    unsigned int transferred_charges_count = 0;
-    std::map<Pixel::Index, std::pair<double, std::vector<const PropagatedCharge*>>> pixel_map;
+    auto thread_num = std::min<size_t>(ThreadPool::threadNum(), collected_maps_.size() - 1);
+    auto& collected_map = collected_maps_[thread_num];
+    collected_map.clear();
     for(const auto& propagated_charge : propagated_message->getData()) {
         auto position = propagated_charge.getLocalPosition();
         // Ignore if outside depth range of implant
@@ -279,70 +309,69 @@ void CapacitiveTransferModule::run(Event* event) {
         auto [xpixel, ypixel] = model_->getPixelIndex(position);
         LOG(DEBUG) << "Hit at pixel " << xpixel << ", " << ypixel;
 
-        for(size_t row = 0; row < max_row_; row++) {
-            for(size_t col = 0; col < max_col_; col++) {
-                if(!cross_coupling_) {
-                    col = static_cast<size_t>(std::floor(matrix_cols_ / 2));
-                    row = static_cast<size_t>(std::floor(matrix_rows_ / 2));
-                }
-
-                auto xcoord = xpixel + static_cast<int>(col - static_cast<size_t>(std::floor(matrix_cols_ / 2)));
-                auto ycoord = ypixel + static_cast<int>(row - static_cast<size_t>(std::floor(matrix_rows_ / 2)));
+        // Pixels outside the grid are kept since their neighbours might be within:
+        auto& collected =
+            collected_map[Pixel::Index(static_cast<unsigned int>(xpixel), static_cast<unsigned int>(ypixel))];
+        collected.charge += static_cast<double>(propagated_charge.getSign() * propagated_charge.getCharge());
+        collected.count += propagated_charge.getCharge();
+        collected.propagated_charges.emplace_back(&propagated_charge);
+    }
 
-                // Ignore if out of pixel grid
-                if(!detector_->getModel()->isWithinPixelGrid(xcoord, ycoord)) {
-                    LOG(DEBUG) << "Skipping set of propagated charges at " << propagated_charge.getLocalPosition()
-                               << " because their nearest pixel (" << xpixel << "," << ypixel
-                               << ") is outside the pixel matrix";
-                    continue;
-                }
+    // Apply the coupling kernel once per pixel with collected charge
+    unsigned int transferred_charges_count = 0;
+    auto& pixel_map = pixel_maps_[thread_num];
+    pixel_map.clear();
+    for(const auto& [source_pixel, collected] : collected_map) {
+        for(const auto& entry : coupling_kernel_) {
+            auto xcoord = static_cast<int>(source_pixel.x()) + entry.dx;
+            auto ycoord = static_cast<int>(source_pixel.y()) + entry.dy;
+
+            // Ignore if out of pixel grid
+            if(!model_->isWithinPixelGrid(xcoord, ycoord)) {
+                LOG(DEBUG) << "Skipping set of " << collected.count << " charges collected at pixel ("
+                           << static_cast<int>(source_pixel.x()) << "," << static_cast<int>(source_pixel.y())
+                           << ") for neighbour (" << xcoord << "," << ycoord << ") outside the pixel matrix";
+                continue;
+            }
 
-                auto pixel_index = Pixel::Index(static_cast<unsigned int>(xcoord), static_cast<unsigned int>(ycoord));
+            auto pixel_index = Pixel::Index(static_cast<unsigned int>(xcoord), static_cast<unsigned int>(ycoord));
 
-                double ccpd_factor = 0;
-                if(config_.has("coupling_scan_file")) {
-                    double local_x = pixel_index.x() * model_->getPixelSize().x();
-                    double local_y = pixel_index.y() * model_->getPixelSize().y();
-                    auto pixel_point = Eigen::Vector3d(local_x, local_y, 0);
-                    auto pixel_projection = plane_.projection(pixel_point);
-                    auto pixel_gap = pixel_projection[2];
+            double ccpd_factor = entry.factor;
+            if(coupling_scan_) {
+                double local_x = pixel_index.x() * model_->getPixelSize().x();
+                double local_y = pixel_index.y() * model_->getPixelSize().y();
+                auto pixel_point = Eigen::Vector3d(local_x, local_y, 0);
+                auto pixel_projection = plane_.projection(pixel_point);
+                auto pixel_gap = pixel_projection[2];
 
-                    ccpd_factor = capacitances_[row * 3 + col]->Eval(
-                                      static_cast<double>(Units::convert(pixel_gap, "um")), nullptr, "S") *
-                                  normalization_;
-                } else if(config_.has("coupling_file")) {
-                    ccpd_factor = relative_coupling_[col][row];
-                } else if(config_.has("coupling_matrix")) {
-                    ccpd_factor = relative_coupling_[max_row_ - row - 1][col];
-                } else {
-                    ccpd_factor = 1;
-                    LOG(ERROR) << "This shouldn't happen. Transferring 100% of detected charge";
-                }
+                ccpd_factor =
+                    capacitances_[entry.index]->Eval(static_cast<double>(Units::convert(pixel_gap, "um")), nullptr, "S") *
+                    normalization_;
 
                 // If there is no cross-coupling (factor is zero) don't create a pixel hit:
                 if(std::fabs(ccpd_factor) < std::numeric_limits<double>::epsilon()) {
                     LOG(TRACE) << "Detected zero coupling, skipping pixel hit creation";
                     continue;
                 }
+            }
 
-                // Update statistics
-                transferred_charges_count += static_cast<unsigned int>(propagated_charge.getCharge() * ccpd_factor);
-                auto neighbour_charge =
-                    static_cast<double>(propagated_charge.getSign() * propagated_charge.getCharge()) * ccpd_factor;
+            // Update statistics
+            transferred_charges_count += static_cast<unsigned int>(collected.count * ccpd_factor);
 
-                LOG(DEBUG) << "Set of " << propagated_charge.getCharge() * ccpd_factor << " charges brought to neighbour "
-                           << col << "," << row << " pixel " << pixel_index << "with cross-coupling of " << ccpd_factor * 100
-                           << "%";
+            LOG(DEBUG) << "Set of " << collected.count * ccpd_factor << " charges brought to neighbour " << entry.dx << ","
+                       << entry.dy << " pixel " << pixel_index << " with cross-coupling of " << ccpd_factor * 100 << "%";
 
-                // Add the pixel the list of hit pixels
-                pixel_map[pixel_index].first += neighbour_charge;
-                pixel_map[pixel_index].second.emplace_back(&propagated_charge);
-            }
+            // Add the pixel the list of hit pixels
+            auto& pixel = pixel_map[pixel_index];
+            pixel.first += collected.charge * ccpd_factor;
+            pixel.second.insert(
+                pixel.second.end(), collected.propagated_charges.begin(), collected.propagated_charges.end());
         }
     }
 
-    // Create pixel charges
+    // Create pixel charges, ordered by pixel index
     LOG(TRACE) << "Combining charges at same pixel";
+    pixel_map.sort();
     std::vector<PixelCharge> pixel_charges;
     for(auto& pixel_index_charge : pixel_map) {
         double charge = pixel_index_charge.second.first;
@@ -22,11 +22,14 @@
 #include "core/messenger/Messenger.hpp"
 #include "core/module/Event.hpp"
 #include "core/module/Module.hpp"
+#include "core/module/ThreadPool.hpp"
 
 #include "objects/Pixel.hpp"
 #include "objects/PixelCharge.hpp"
 #include "objects/PropagatedCharge.hpp"
 
+#include "tools/pixel_map.h"
+
 namespace allpix {
     /**
      * @ingroup Modules
@@ -81,9 +84,36 @@ namespace allpix {
         unsigned int max_row_{};
         unsigned int max_col_{};
 
+        // Non-zero entries of the coupling matrix with their offset from the pixel the charge is collected at
+        struct CouplingEntry {
+            int dx;
+            int dy;
+            size_t index;
+            double factor;
+        };
+        std::vector<CouplingEntry> coupling_kernel_;
+
+        // Charge collected at a pixel before applying the coupling
+        struct CollectedCharge {
+            double charge{};
+            unsigned int count{};
+            std::vector<const PropagatedCharge*> propagated_charges;
+
+            void clear() {
+                charge = 0;
+                count = 0;
+                propagated_charges.clear();
+            }
+        };
+
+        // Pixel maps of all worker threads, cleared for every event to reuse their storage
+        std::vector<PixelMap<CollectedCharge>> collected_maps_;
+        std::vector<PixelMap<std::pair<double, std::vector<const PropagatedCharge*>>>> pixel_maps_;
+
         double normalization_{};
         double max_depth_distance_{};
         bool cross_coupling_{};
+        bool coupling_scan_{};
 
         void getCapacitanceScan(TFile* root_file);
         TGraph* capacitances_[9]{};
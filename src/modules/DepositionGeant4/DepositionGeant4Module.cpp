@@ -74,6 +74,10 @@ DepositionGeant4Module::DepositionGeant4Module(Configuration& config, Messenger*
     // Default value chosen to ensure proper gamma generation for Cs137 decay
     config_.setDefault<double>("cutoff_time", 2.21e+11);
 
+    // Set defaults for the selection of stored MCTracks
+    config_.setDefault<TrackInfoManager::Selection>("mc_track_selection", TrackInfoManager::Selection::SENSOR);
+    config_.setDefault<double>("mc_track_min_energy", 0);
+
     // Create user limits for maximum step length and maximum event time in the sensor
     user_limits_ =
         std::make_unique<G4UserLimits>(config_.get<double>("max_step_length"), DBL_MAX, config_.get<double>("cutoff_time"));
@@ -113,6 +117,10 @@ void DepositionGeant4Module::initialize() {
     number_of_particles_ = config_.get<unsigned int>("number_of_particles", 1);
     output_plots_ = config_.get<bool>("output_plots");
 
+    mc_track_selection_ = config_.get<TrackInfoManager::Selection>("mc_track_selection");
+    mc_track_min_energy_ = config_.get<double>("mc_track_min_energy");
+    mc_track_particles_ = config_.getArray<int>("mc_track_particles", {});
+
     // Load the G4 run manager (which is owned by the geometry builder)
     if(multithreadingEnabled()) {
         run_manager_g4_ = G4MTRunManager::GetMasterRunManager();
@@ -256,7 +264,8 @@ void DepositionGeant4Module::initialize() {
     // Construct the sensitive detectors and fields.
     if(run_manager_mt == nullptr) {
         // Create the info track manager for the main thread before creating the Sensitive detectors.
-        track_info_manager_ = std::make_unique<TrackInfoManager>();
+        track_info_manager_ =
+            std::make_unique<TrackInfoManager>(mc_track_selection_, mc_track_min_energy_, mc_track_particles_);
         construct_sensitive_detectors_and_fields(fano_factor, charge_creation_energy, cutoff_time);
     } else {
         // In MT-mode we register a builder that will be called for each thread to construct the SD when needed.
@@ -280,7 +289,8 @@ void DepositionGeant4Module::initializeThread() {
         // In MT-mode the sensitive detectors will be created with the calls to BeamOn. So we construct the
         // track manager for each calling thread here.
         if(track_info_manager_ == nullptr) {
-            track_info_manager_ = std::make_unique<TrackInfoManager>();
+            track_info_manager_ =
+                std::make_unique<TrackInfoManager>(mc_track_selection_, mc_track_min_energy_, mc_track_particles_);
         }
 
         run_manager_mt->InitializeForThread();
@@ -109,6 +109,11 @@ namespace allpix {
         bool output_plots_{};
         unsigned int number_of_particles_{};
 
+        // Selection and filters of the stored MCTracks
+        TrackInfoManager::Selection mc_track_selection_{};
+        double mc_track_min_energy_{};
+        std::vector<int> mc_track_particles_;
+
         // The track manager which this module uses to assign custom track IDs and manage & create MCTracks
         static thread_local std::unique_ptr<TrackInfoManager> track_info_manager_;
 
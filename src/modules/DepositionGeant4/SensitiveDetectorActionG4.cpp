@@ -100,7 +100,7 @@ G4bool SensitiveDetectorActionG4::ProcessHits(G4Step* step, G4TouchableHistory*)
 
     // Save begin point when track is seen for the first time
     if(track_begin_.find(trackID) == track_begin_.end()) {
-        track_info_manager_->setTrackInfoToBeStored(trackID);
+        track_info_manager_->setTrackInfoToBeStored(trackID, false);
         auto start_position = detector_->getLocalPosition(static_cast<ROOT::Math::XYZPoint>(preStep->GetPosition()));
         track_begin_.emplace(trackID, start_position);
         track_parents_.emplace(trackID, parentTrackID);
@@ -117,6 +117,9 @@ G4bool SensitiveDetectorActionG4::ProcessHits(G4Step* step, G4TouchableHistory*)
         return false;
     }
 
+    // Register the track as depositing charge for the selection of stored MCTracks
+    track_info_manager_->setTrackInfoToBeStored(trackID, true);
+
     // Store relevant quantities to create charge deposits:
     deposit_position_.push_back(deposit_position);
     deposit_charge_.push_back(charge);
@@ -152,6 +155,7 @@ void SensitiveDetectorActionG4::dispatchMessages(Module* module, Messenger* mess
 
     // Create the mc particles
     std::vector<MCParticle> mc_particles;
+    mc_particles.reserve(track_begin_.size());
     for(auto& track_id_point : track_begin_) {
         auto track_id = track_id_point.first;
         auto local_begin = track_id_point.second;
@@ -204,6 +208,7 @@ void SensitiveDetectorActionG4::dispatchMessages(Module* module, Messenger* mess
     if(!deposit_position_.empty()) {
         // Prepare charge deposits for this event
         std::vector<DepositedCharge> deposits;
+        deposits.reserve(2 * deposit_position_.size());
         for(size_t i = 0; i < deposit_position_.size(); i++) {
             auto local_position = deposit_position_.at(i);
             auto global_position = detector_->getGlobalPosition(local_position);
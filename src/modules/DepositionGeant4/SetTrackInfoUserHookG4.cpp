@@ -12,6 +12,8 @@
 #include "DepositionGeant4Module.hpp"
 #include "TrackInfoG4.hpp"
 
+#include "G4TrackingManager.hh"
+
 using namespace allpix;
 
 void SetTrackInfoUserHookG4::PreUserTrackingAction(const G4Track* aTrack) {
@@ -30,5 +32,8 @@ void SetTrackInfoUserHookG4::PostUserTrackingAction(const G4Track* aTrack) {
     auto userInfoOwningPtr = std::unique_ptr<TrackInfoG4>(userInfo);
     auto theTrack = const_cast<G4Track*>(aTrack); // NOLINT
     theTrack->SetUserInformation(nullptr);
-    module_->track_info_manager_->storeTrackInfo(std::move(userInfoOwningPtr));
+    // Only tracks which produced secondaries can be parents of later tracks
+    const auto* secondaries = fpTrackingManager->GimmeSecondaries();
+    auto has_secondaries = (secondaries != nullptr && !secondaries->empty());
+    module_->track_info_manager_->storeTrackInfo(std::move(userInfoOwningPtr), aTrack->GetTrackID(), has_secondaries);
 }
@@ -11,7 +11,8 @@
 
 using namespace allpix;
 
-TrackInfoManager::TrackInfoManager() : counter_(1) {}
+TrackInfoManager::TrackInfoManager(Selection selection, double min_energy, const std::vector<int>& particles)
+    : selection_(selection), min_energy_(min_energy), particles_(particles.begin(), particles.end()), counter_(1) {}
 
 std::unique_ptr<TrackInfoG4> TrackInfoManager::makeTrackInfo(const G4Track* const track) {
     auto custom_id = counter_++;
@@ -22,27 +23,47 @@ std::unique_ptr<TrackInfoG4> TrackInfoManager::makeTrackInfo(const G4Track* cons
     return std::make_unique<TrackInfoG4>(custom_id, parent_track_id, track);
 }
 
-void TrackInfoManager::setTrackInfoToBeStored(int track_id) {
-    auto element = std::find(to_store_track_ids_.begin(), to_store_track_ids_.end(), track_id);
-    // If track id is not present we add it, otherwise skip as we only need each track once
-    if(element == to_store_track_ids_.end()) {
-        to_store_track_ids_.emplace_back(track_id);
+void TrackInfoManager::setTrackInfoToBeStored(int track_id, bool deposited_charge) {
+    // Tracks only entering a sensor are not enough if only tracks with charge deposits are selected
+    if(deposited_charge || selection_ == Selection::SENSOR) {
+        to_store_track_ids_.insert(track_id);
     }
 }
 
-void TrackInfoManager::storeTrackInfo(std::unique_ptr<TrackInfoG4> the_track_info) {
+void TrackInfoManager::storeTrackInfo(std::unique_ptr<TrackInfoG4> the_track_info, int g4_track_id, bool has_secondaries) {
     auto track_id = the_track_info->getID();
-    auto element = std::find(to_store_track_ids_.begin(), to_store_track_ids_.end(), track_id);
-    if(element != to_store_track_ids_.end()) {
+    auto accepted = accept_track(*the_track_info);
+    auto stored = (to_store_track_ids_.erase(track_id) > 0 && accepted);
+
+    if(stored) {
         stored_track_infos_.push_back(std::move(the_track_info));
-        to_store_track_ids_.erase(element);
+    } else if(has_secondaries && accepted && selection_ == Selection::ANCESTORS) {
+        // Keep the track until it is known whether one of its descendants is stored
+        ancestor_track_infos_.emplace(track_id, std::move(the_track_info));
+    }
+
+    // Tracks without secondaries are no parents, and the parent of a track is only needed further if the track is stored or
+    // its ancestors are searched for its descendants
+    if(!has_secondaries) {
+        g4_to_custom_id_.erase(g4_track_id);
+    }
+    if(!stored && (!has_secondaries || selection_ != Selection::ANCESTORS)) {
+        track_id_to_parent_id_.erase(track_id);
+    }
+}
+
+bool TrackInfoManager::accept_track(const TrackInfoG4& track_info) const {
+    if(track_info.getKineticEnergyInitial() < min_energy_) {
+        return false;
     }
+    return particles_.empty() || particles_.find(track_info.getParticleID()) != particles_.end();
 }
 
 void TrackInfoManager::resetTrackInfoManager() {
     counter_ = 1;
     stored_tracks_.clear();
     to_store_track_ids_.clear();
+    ancestor_track_infos_.clear();
     g4_to_custom_id_.clear();
     track_id_to_parent_id_.clear();
     stored_track_infos_.clear();
@@ -69,6 +90,31 @@ MCTrack const* TrackInfoManager::findMCTrack(int track_id) const {
 }
 
 void TrackInfoManager::createMCTracks() {
+    // Add the kept ancestors of all stored tracks, walking up the parents until the primary or a stored track is reached
+    if(selection_ == Selection::ANCESTORS) {
+        std::unordered_set<int> stored_ids;
+        for(auto& track_info : stored_track_infos_) {
+            stored_ids.insert(track_info->getID());
+        }
+
+        auto number_of_tracks = stored_track_infos_.size();
+        for(size_t ix = 0; ix < number_of_tracks; ++ix) {
+            for(auto parent = track_id_to_parent_id_.find(stored_track_infos_[ix]->getID());
+                parent != track_id_to_parent_id_.end() && parent->second != 0;
+                parent = track_id_to_parent_id_.find(parent->second)) {
+                auto ancestor = ancestor_track_infos_.find(parent->second);
+                if(ancestor != ancestor_track_infos_.end()) {
+                    stored_ids.insert(ancestor->first);
+                    stored_track_infos_.push_back(std::move(ancestor->second));
+                    ancestor_track_infos_.erase(ancestor);
+                } else if(stored_ids.count(parent->second) != 0) {
+                    break;
+                }
+            }
+        }
+        ancestor_track_infos_.clear();
+    }
+
     // Reserve size so we don't move the vector around and change addresses:
     stored_tracks_.reserve(stored_track_infos_.size());
 
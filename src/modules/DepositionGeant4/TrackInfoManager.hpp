@@ -11,7 +11,9 @@
 #ifndef TrackInfoManager_H
 #define TrackInfoManager_H 1
 
-#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "G4Track.hh"
 #include "TrackInfoG4.hpp"
@@ -27,9 +29,23 @@ namespace allpix {
     class TrackInfoManager {
     public:
         /**
-         * @brief Default constructor
+         * @brief Selection of the tracks stored as MCTrack
          */
-        TrackInfoManager();
+        enum class Selection {
+            SENSOR = 0, ///< All tracks which entered the sensor of a detector
+            CHARGE,     ///< Only tracks which deposited charge in the sensor of a detector
+            ANCESTORS,  ///< Tracks which deposited charge in the sensor of a detector and all their ancestors
+        };
+
+        /**
+         * @brief Constructor
+         * @param selection  Selection of the tracks to be stored
+         * @param min_energy Minimum initial kinetic energy of stored tracks
+         * @param particles  PDG codes of the particles to be stored, all particles are stored if empty
+         */
+        explicit TrackInfoManager(Selection selection = Selection::SENSOR,
+                                  double min_energy = 0,
+                                  const std::vector<int>& particles = {});
 
         /**
          * @brief Factory method for TrackInfoG4 instances
@@ -43,19 +59,24 @@ namespace allpix {
 
         /**
          * @brief Will take a MCTrack and attempt to store it
-         * @param the_track_info The MCTrack to be (possibly) stored
+         * @param the_track_info  The MCTrack to be (possibly) stored
+         * @param g4_track_id     The Geant4 id of the finished track
+         * @param has_secondaries True if the track produced secondary tracks
          *
-         * It will be stored if it was registered to be stored (@see #setTrackInfoToBeStored), otherwise deleted
+         * It will be stored if it was registered to be stored (@see #setTrackInfoToBeStored) and passes the energy and
+         * particle filters, otherwise deleted. Tracks without secondaries cannot be parents of later tracks, such that all
+         * their bookkeeping is dropped unless they are stored.
          */
-        void storeTrackInfo(std::unique_ptr<TrackInfoG4> the_track_info);
+        void storeTrackInfo(std::unique_ptr<TrackInfoG4> the_track_info, int g4_track_id, bool has_secondaries);
 
         /**
-         * @brief Will register a track id to be stored
-         * @param track_id The id of the track to be stored
+         * @brief Will register a track id to be stored, depending on the selection of tracks
+         * @param track_id         The id of the track to be stored
+         * @param deposited_charge True if the track deposited charge, false if it only entered a sensor
          *
          * The track itself will have to be provided via @see storeTrackInfo once finished
          */
-        void setTrackInfoToBeStored(int track_id);
+        void setTrackInfoToBeStored(int track_id, bool deposited_charge);
 
         /**
          * @brief Reset of the TrackInfoManager instance
@@ -97,14 +118,28 @@ namespace allpix {
          */
         void set_all_track_parents();
 
+        /**
+         * @brief Check if a track passes the energy and particle filters
+         * @param track_info Information of the finished track
+         * @return True if the track may be stored, false otherwise
+         */
+        bool accept_track(const TrackInfoG4& track_info) const;
+
+        // Selection and filters of the stored tracks
+        Selection selection_;
+        double min_energy_;
+        std::unordered_set<int> particles_;
+
         // Counter to store highest assigned track id
         int counter_{};
-        // Geant4 id to custom id translation
-        std::map<int, int> g4_to_custom_id_{};
-        // Custom id to custom parent id tracking
-        std::map<int, int> track_id_to_parent_id_{};
-        // List of track ids to be stored if they are provided via #storeTrackInfo
-        std::vector<int> to_store_track_ids_;
+        // Geant4 id to custom id translation, only kept for tracks which can still be parents
+        std::unordered_map<int, int> g4_to_custom_id_{};
+        // Custom id to custom parent id tracking, only kept for possible parents and stored tracks
+        std::unordered_map<int, int> track_id_to_parent_id_{};
+        // Set of track ids to be stored if they are provided via #storeTrackInfo
+        std::unordered_set<int> to_store_track_ids_;
+        // Finished tracks with secondaries which are stored if one of their descendants is stored
+        std::unordered_map<int, std::unique_ptr<TrackInfoG4>> ancestor_track_infos_;
         // The TrackInfoG4 instances which are handed over to this track manager
         std::vector<std::unique_ptr<TrackInfoG4>> stored_track_infos_;
         // The MCTrack vector which is dispatched via #dispatchMessage
@@ -112,7 +147,7 @@ namespace allpix {
         // Ids ins same order as tracks stored in #stored_tracks_
         std::vector<int> stored_track_ids_;
         // Id to index in #stored_tracks_ for easier handling
-        std::map<int, MCTrack const*> id_to_track_;
+        std::unordered_map<int, MCTrack const*> id_to_track_;
     };
 } // namespace allpix
 #endif /* TrackInfoManager_H */
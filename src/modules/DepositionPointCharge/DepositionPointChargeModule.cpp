@@ -204,6 +204,7 @@ void DepositionPointChargeModule::DepositLine(Event* event, const ROOT::Math::XY
                << Units::display(end_global, {"um", "mm"}) << " in detector " << detector_->getName();
 
     // Deposit the charge carriers:
+    charges.reserve(2 * static_cast<size_t>(std::ceil(model->getSensorSize().z() / step_size_z_)));
     auto position_local = start_local;
     while(position_local.z() < model->getSensorSize().z() / 2.0) {
         position_local += ROOT::Math::XYZVector(0, 0, step_size_z_);
@@ -10,6 +10,8 @@
 #include "DetectorHistogrammerModule.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
@@ -45,6 +47,8 @@ DetectorHistogrammerModule::DetectorHistogrammerModule(Configuration& config,
         DisplacementVector2D<Cartesian2D<int>>(static_cast<int>(Units::convert(model->getPixelSize().x(), "um")),
                                                static_cast<int>(Units::convert(model->getPixelSize().y(), "um"))));
     config_.setDefault<double>("max_cluster_charge", Units::get(50., "ke"));
+    config_.setDefault<int>("max_pixel_map_bins", 250000);
+    config_.setDefault<int>("max_multiplicity", 10000);
 
     matching_cut_ = config_.get<XYVector>("matching_cut");
     track_resolution_ = config_.get<XYVector>("track_resolution");
@@ -61,20 +65,47 @@ void DetectorHistogrammerModule::initialize() {
     auto xpixels = static_cast<int>(model->getNPixels().x());
     auto ypixels = static_cast<int>(model->getNPixels().y());
 
+    // Group square blocks of pixels into one bin of the pixel maps if the pixel matrix exceeds the maximum number of bins
+    auto max_pixel_map_bins = config_.get<int>("max_pixel_map_bins");
+    if(max_pixel_map_bins <= 0) {
+        throw InvalidValueError(config_, "max_pixel_map_bins", "maximum number of bins has to be positive");
+    }
+    auto map_group = std::max(
+        1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(xpixels) * ypixels / max_pixel_map_bins))));
+    while(static_cast<long>((xpixels + map_group - 1) / map_group) * ((ypixels + map_group - 1) / map_group) >
+          max_pixel_map_bins) {
+        ++map_group;
+    }
+    auto map_bins_x = (xpixels + map_group - 1) / map_group;
+    auto map_bins_y = (ypixels + map_group - 1) / map_group;
+    auto map_max_x = map_bins_x * map_group - 0.5;
+    auto map_max_y = map_bins_y * map_group - 0.5;
+    if(map_group > 1) {
+        LOG(INFO) << "Grouping " << map_group << "x" << map_group << " pixels into one bin of the pixel maps, "
+                  << map_bins_x << "x" << map_bins_y << " bins instead of " << xpixels << "x" << ypixels;
+    }
+
+    // Limit the range of the multiplicity histograms, larger values are counted in the overflow bin
+    auto max_multiplicity = config_.get<int>("max_multiplicity");
+    if(max_multiplicity <= 0) {
+        throw InvalidValueError(config_, "max_multiplicity", "maximum multiplicity has to be positive");
+    }
+    auto event_size_bins = std::min(xpixels * ypixels, max_multiplicity);
+
     // Create histogram of hitmap
     LOG(TRACE) << "Creating histograms";
     std::string hit_map_title = "Hitmap for " + detector_->getName() + ";x (pixels);y (pixels);hits";
-    hit_map =
-        CreateHistogram<TH2D>("hit_map", hit_map_title.c_str(), xpixels, -0.5, xpixels - 0.5, ypixels, -0.5, ypixels - 0.5);
+    hit_map = CreateHistogram<TH2D>(
+        "hit_map", hit_map_title.c_str(), map_bins_x, -0.5, map_max_x, map_bins_y, -0.5, map_max_y);
 
     std::string charge_map_title = "Charge map for " + detector_->getName() + ";x (pixels);y (pixels); charge [ke]";
     charge_map = CreateHistogram<TH2D>(
-        "charge_map", charge_map_title.c_str(), xpixels, -0.5, xpixels - 0.5, ypixels, -0.5, ypixels - 0.5);
+        "charge_map", charge_map_title.c_str(), map_bins_x, -0.5, map_max_x, map_bins_y, -0.5, map_max_y);
 
     // Create histogram of cluster map
     std::string cluster_map_title = "Cluster map for " + detector_->getName() + ";x (pixels);y (pixels); clusters";
     cluster_map = CreateHistogram<TH2D>(
-        "cluster_map", cluster_map_title.c_str(), xpixels, -0.5, xpixels - 0.5, ypixels, -0.5, ypixels - 0.5);
+        "cluster_map", cluster_map_title.c_str(), map_bins_x, -0.5, map_max_x, map_bins_y, -0.5, map_max_y);
 
     // Calculate the granularity of in-pixel maps:
     auto inpixel_bins = config_.get<DisplacementVector2D<Cartesian2D<int>>>("granularity");
@@ -144,19 +175,23 @@ void DetectorHistogrammerModule::initialize() {
 
     // Create cluster size plots, preventing a zero-bin histogram by scaling with integer ceiling: (x + y - 1) / y
     std::string cluster_size_title = "Cluster size for " + detector_->getName() + ";cluster size [px];clusters";
-    cluster_size = CreateHistogram<TH1D>(
-        "cluster_size", cluster_size_title.c_str(), (xpixels * ypixels + 9) / 10, 0.5, (xpixels * ypixels + 9) / 10 + 0.5);
+    auto cluster_size_bins = std::min((xpixels * ypixels + 9) / 10, max_multiplicity);
+    cluster_size =
+        CreateHistogram<TH1D>("cluster_size", cluster_size_title.c_str(), cluster_size_bins, 0.5, cluster_size_bins + 0.5);
 
     std::string cluster_size_x_title = "Cluster size X for " + detector_->getName() + ";cluster size x [px];clusters";
-    cluster_size_x = CreateHistogram<TH1D>("cluster_size_x", cluster_size_x_title.c_str(), xpixels, 0.5, xpixels + 0.5);
+    auto cluster_size_x_bins = std::min(xpixels, max_multiplicity);
+    cluster_size_x = CreateHistogram<TH1D>(
+        "cluster_size_x", cluster_size_x_title.c_str(), cluster_size_x_bins, 0.5, cluster_size_x_bins + 0.5);
 
     std::string cluster_size_y_title = "Cluster size Y for " + detector_->getName() + ";cluster size y [px];clusters";
-    cluster_size_y = CreateHistogram<TH1D>("cluster_size_y", cluster_size_y_title.c_str(), ypixels, 0.5, ypixels + 0.5);
+    auto cluster_size_y_bins = std::min(ypixels, max_multiplicity);
+    cluster_size_y = CreateHistogram<TH1D>(
+        "cluster_size_y", cluster_size_y_title.c_str(), cluster_size_y_bins, 0.5, cluster_size_y_bins + 0.5);
 
     // Create event size plot
     std::string event_size_title = "Event size for " + detector_->getName() + ";event size [px];events";
-    event_size =
-        CreateHistogram<TH1D>("event_size", event_size_title.c_str(), xpixels * ypixels, 0.5, xpixels * ypixels + 0.5);
+    event_size = CreateHistogram<TH1D>("event_size", event_size_title.c_str(), event_size_bins, 0.5, event_size_bins + 0.5);
 
     // Create residual plots
     std::string residual_x_title = "Residual in X for " + detector_->getName() + ";x_{track} - x_{cluster} [#mum];events";
@@ -199,7 +234,7 @@ void DetectorHistogrammerModule::initialize() {
     std::string residual_detector_title = "Mean absolute deviation of residual of " + detector_->getName() +
                                           ";x (pixels);y (pixels);MAD(#sqrt{#Deltax^{2}+#Deltay^{2}}) [#mum]";
     residual_detector = CreateHistogram<TProfile2D>(
-        "residual_detector", residual_detector_title.c_str(), xpixels, -0.5, xpixels - 0.5, ypixels, -0.5, ypixels - 0.5);
+        "residual_detector", residual_detector_title.c_str(), map_bins_x, -0.5, map_max_x, map_bins_y, -0.5, map_max_y);
 
     std::string residual_x_map_title =
         "Mean absolute deviation of residual in X as function of in-pixel impact position for " + detector_->getName() +
@@ -216,12 +251,12 @@ void DetectorHistogrammerModule::initialize() {
         "Mean absolute deviation of residual in X of " + detector_->getName() + ";x (pixels);y (pixels);MAD(#Deltax) [#mum]";
     residual_x_detector = CreateHistogram<TProfile2D>("residual_x_detector",
                                                       residual_x_detector_title.c_str(),
-                                                      xpixels,
+                                                      map_bins_x,
                                                       -0.5,
-                                                      xpixels - 0.5,
-                                                      ypixels,
+                                                      map_max_x,
+                                                      map_bins_y,
                                                       -0.5,
-                                                      ypixels - 0.5);
+                                                      map_max_y);
 
     std::string residual_y_map_title =
         "Mean absolute deviation of residual in Y as function of in-pixel impact position for " + detector_->getName() +
@@ -238,12 +273,12 @@ void DetectorHistogrammerModule::initialize() {
         "Mean absolute deviation of residual in Y of " + detector_->getName() + ";x (pixels);y (pixels);MAD(#Deltay) [#mum]";
     residual_y_detector = CreateHistogram<TProfile2D>("residual_y_detector",
                                                       residual_y_detector_title.c_str(),
-                                                      xpixels,
+                                                      map_bins_x,
                                                       -0.5,
-                                                      xpixels - 0.5,
-                                                      ypixels,
+                                                      map_max_x,
+                                                      map_bins_y,
                                                       -0.5,
-                                                      ypixels - 0.5);
+                                                      map_max_y);
 
     // Efficiency maps:
     std::string efficiency_map_title = "Efficiency as function of in-pixel impact position for " + detector_->getName() +
@@ -261,12 +296,12 @@ void DetectorHistogrammerModule::initialize() {
     std::string efficiency_detector_title = "Efficiency of " + detector_->getName() + ";x (pixels);y (pixels);efficiency";
     efficiency_detector = CreateHistogram<TProfile2D>("efficiency_detector",
                                                       efficiency_detector_title.c_str(),
-                                                      xpixels,
+                                                      map_bins_x,
                                                       -0.5,
-                                                      xpixels - 0.5,
-                                                      ypixels,
+                                                      map_max_x,
+                                                      map_bins_y,
                                                       -0.5,
-                                                      ypixels - 0.5,
+                                                      map_max_y,
                                                       0,
                                                       1);
     // Efficiency projections
@@ -281,7 +316,7 @@ void DetectorHistogrammerModule::initialize() {
 
     // Create number of clusters plot
     std::string n_cluster_title = "Number of clusters for " + detector_->getName() + ";clusters;events";
-    n_cluster = CreateHistogram<TH1D>("n_cluster", n_cluster_title.c_str(), xpixels * ypixels, 0.5, xpixels * ypixels + 0.5);
+    n_cluster = CreateHistogram<TH1D>("n_cluster", n_cluster_title.c_str(), event_size_bins, 0.5, event_size_bins + 0.5);
 
     // Create cluster charge plot
     auto max_cluster_charge = Units::convert(config_.get<double>("max_cluster_charge"), "ke");
@@ -300,6 +335,9 @@ void DetectorHistogrammerModule::initialize() {
     std::string total_charge_title = "Total charge per event for " + detector_->getName() + ";total charge [ke];events";
     total_charge = CreateHistogram<TH1D>(
         "total_charge", total_charge_title.c_str(), 1000, 0., static_cast<double>(max_cluster_charge * 4));
+
+    // Prepare one clustering for every thread that can run events
+    clusterings_.resize(ThreadPool::threadCount());
 }
 
 void DetectorHistogrammerModule::run(Event* event) {
@@ -616,52 +654,25 @@ void DetectorHistogrammerModule::finalize() {
  * @brief Perform a sparse clustering on the PixelHits
  */
 std::vector<Cluster> DetectorHistogrammerModule::doClustering(std::shared_ptr<PixelHitMessage>& pixels_message) {
-    std::vector<Cluster> clusters;
-    std::map<const PixelHit*, bool> usedPixel;
-
-    auto pixel_it = pixels_message->getData().begin();
-    for(; pixel_it != pixels_message->getData().end(); pixel_it++) {
-        const PixelHit* pixel_hit = &(*pixel_it);
+    const auto& pixel_hits = pixels_message->getData();
 
-        // Check if the pixel has been used:
-        if(usedPixel[pixel_hit]) {
-            continue;
-        }
+    // Group adjacent pixel hits, reusing the clustering buffers of this thread for all events:
+    auto& clustering = clusterings_[std::min<size_t>(ThreadPool::threadNum(), clusterings_.size() - 1)];
+    auto cluster_count = clustering(pixel_hits);
 
-        // Create new cluster
-        Cluster cluster(pixel_hit);
-        usedPixel[pixel_hit] = true;
-        LOG(TRACE) << "Creating new cluster with seed: " << pixel_hit->getPixel().getIndex();
-
-        auto touching = [&](const PixelHit* pixel) {
-            auto pxi1 = pixel->getIndex();
-            for(const auto& cluster_pixel : cluster.getPixelHits()) {
-
-                auto distance = [](unsigned int lhs, unsigned int rhs) { return (lhs > rhs ? lhs - rhs : rhs - lhs); };
-
-                auto pxi2 = cluster_pixel->getIndex();
-                if(distance(pxi1.x(), pxi2.x()) <= 1 && distance(pxi1.y(), pxi2.y()) <= 1) {
-                    return true;
-                }
-            }
-            return false;
-        };
-
-        // Keep adding pixels to the cluster:
-        for(auto other_pixel = pixel_it + 1; other_pixel != pixels_message->getData().end(); other_pixel++) {
-            const PixelHit* neighbor = &(*other_pixel);
-
-            // Check if neighbor has been used or if it touches the current cluster:
-            if(usedPixel[neighbor] || !touching(neighbor)) {
-                continue;
-            }
-
-            cluster.addPixelHit(neighbor);
-            LOG(TRACE) << "Adding pixel: " << neighbor->getPixel().getIndex();
-            usedPixel[neighbor] = true;
-            other_pixel = pixel_it;
+    // Create a cluster for every group, starting from its first pixel hit:
+    std::vector<Cluster> clusters;
+    clusters.reserve(cluster_count);
+    for(size_t index = 0; index < cluster_count; ++index) {
+        auto [begin, end] = clustering.getCluster(index);
+        Cluster cluster(&pixel_hits[*begin]);
+        LOG(TRACE) << "Creating new cluster with seed: " << pixel_hits[*begin].getPixel().getIndex();
+
+        for(auto hit = std::next(begin); hit != end; ++hit) {
+            cluster.addPixelHit(&pixel_hits[*hit]);
+            LOG(TRACE) << "Adding pixel: " << pixel_hits[*hit].getPixel().getIndex();
         }
-        clusters.push_back(cluster);
+        clusters.push_back(std::move(cluster));
     }
     return clusters;
 }
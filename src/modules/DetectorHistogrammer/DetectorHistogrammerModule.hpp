@@ -25,10 +25,12 @@
 #include "core/messenger/Messenger.hpp"
 #include "core/module/Event.hpp"
 #include "core/module/Module.hpp"
+#include "core/module/ThreadPool.hpp"
 
 #include "Cluster.hpp"
 #include "objects/PixelHit.hpp"
 #include "tools/ROOT.h"
+#include "tools/pixel_clustering.h"
 
 namespace allpix {
     /**
@@ -66,7 +68,7 @@ namespace allpix {
         /**
          * @brief Perform a sparse clustering on the PixelHits
          */
-        static std::vector<Cluster> doClustering(std::shared_ptr<PixelHitMessage>& pixels_message);
+        std::vector<Cluster> doClustering(std::shared_ptr<PixelHitMessage>& pixels_message);
 
         /**
          * @brief analyze the available MCParticles and return the all particles identified as primary (i.e. that do not have
@@ -81,6 +83,9 @@ namespace allpix {
         // Statistics
         std::atomic<unsigned long> total_hits_{};
 
+        // Clustering buffers of all worker threads, reused for every event
+        std::vector<PixelClustering> clusterings_;
+
         // Cut criteria for efficiency measurement:
         ROOT::Math::XYVector matching_cut_{};
 
@@ -13,6 +13,7 @@
 #include <utility>
 
 #include "core/utils/log.h"
+#include "tools/field_reduction.h"
 
 using namespace allpix;
 
@@ -57,8 +58,70 @@ void DopingProfileReaderModule::initialize() {
         std::array<double, 2> field_offset{{offset.x(), offset.y()}};
 
         auto field_data = read_field(field_scale);
-        detector_->setDopingProfileGrid(
-            field_data.getData(), field_data.getDimensions(), field_scale, field_offset, thickness_domain);
+
+        // Reduce the doping concentration map if it does not change along x and/or y:
+        std::array<bool, 2> reduced_axes{};
+        if(config_.get<bool>("reduce_field_dimensions", false)) {
+            reduced_axes =
+                find_invariant_axes(field_data, FieldQuantity::SCALAR, config_.get<double>("reduction_tolerance", 1e-6));
+            if(reduced_axes[0] || reduced_axes[1]) {
+                field_data = collapse_axes(field_data, FieldQuantity::SCALAR, reduced_axes);
+                LOG(INFO) << "Doping concentration map is invariant along" << (reduced_axes[0] ? " x" : "")
+                          << (reduced_axes[1] ? " y" : "") << ", reduced to " << field_data.getDimensions().at(0) << "x"
+                          << field_data.getDimensions().at(1) << "x" << field_data.getDimensions().at(2) << " cells";
+            }
+        }
+
+        // Only store the upper half or quadrant of the map if it is symmetric with respect to the center of the map:
+        auto dimensions = field_data.getDimensions();
+        auto full_field = field_data;
+        std::array<bool, 2> mirrored_axes{};
+        if(config_.get<bool>("mirror_symmetry", false)) {
+            mirrored_axes =
+                find_symmetric_axes(field_data, FieldQuantity::SCALAR, config_.get<double>("symmetry_tolerance", 1e-6));
+            for(size_t axis = 0; axis < 2; ++axis) {
+                if(dimensions.at(axis) > 1 && !mirrored_axes.at(axis)) {
+                    throw InvalidValueError(config_,
+                                            "mirror_symmetry",
+                                            std::string("doping concentration map is not mirror-symmetric along ") +
+                                                (axis == 0 ? "x" : "y") + " within the configured tolerance");
+                }
+            }
+            field_data = mirror_axes(field_data, FieldQuantity::SCALAR, mirrored_axes);
+            LOG(INFO) << "Doping concentration map is mirror-symmetric, storing " << field_data.getDimensions().at(0)
+                      << "x" << field_data.getDimensions().at(1) << "x" << field_data.getDimensions().at(2) << " cells";
+        }
+
+        detector_->setDopingProfileGrid(field_data.getData(),
+                                        dimensions,
+                                        field_scale,
+                                        field_offset,
+                                        thickness_domain,
+                                        reduced_axes,
+                                        mirrored_axes);
+
+        // Verify that lookups in all quadrants of a mirrored map reproduce the full doping concentration map:
+        if(mirrored_axes[0] || mirrored_axes[1]) {
+            auto pitch = model->getPixelSize();
+            auto deviation = find_mirror_deviation(
+                full_field,
+                FieldQuantity::SCALAR,
+                {{field_scale[0] * pitch.x(), field_scale[1] * pitch.y()}},
+                thickness_domain,
+                [&](double x, double y, double z) {
+                    // Convert from the center of the map to local coordinates of the first map replica:
+                    return detector_->getDopingConcentration(
+                        ROOT::Math::XYZPoint(x - field_offset[0] + 0.5 * (field_scale[0] - 1) * pitch.x(),
+                                             y - field_offset[1] + 0.5 * (field_scale[1] - 1) * pitch.y(),
+                                             z));
+                });
+            if(deviation > config_.get<double>("symmetry_tolerance", 1e-6)) {
+                LOG(WARNING) << "Lookups of the mirrored doping concentration map deviate from the full map by up to "
+                             << deviation << " of its maximum value";
+            } else {
+                LOG(DEBUG) << "Lookups of the mirrored doping concentration map match the full map in all quadrants";
+            }
+        }
 
     } else if(field_model == DopingProfile::CONSTANT) {
         LOG(TRACE) << "Adding constant doping concentration";
@@ -110,8 +173,9 @@ FieldData<double> DopingProfileReaderModule::read_field(std::array<double, 2> fi
     try {
         LOG(TRACE) << "Fetching doping concentration map from mesh file";
 
-        // Get field from file
-        auto field_data = field_parser_.getByFileName(config_.getPath("file_name", true), "/cm/cm/cm");
+        // Get field from file, storing parsed INIT files in the cache directory if requested
+        auto cache_directory = config_.has("field_cache_directory") ? config_.getPath("field_cache_directory") : "";
+        auto field_data = field_parser_.getByFileName(config_.getPath("file_name", true), "/cm/cm/cm", cache_directory);
 
         // Check if electric field matches chip
         check_detector_match(field_data.getSize(), field_scale);
@@ -25,6 +25,7 @@
 #include "core/geometry/DetectorModel.hpp"
 #include "core/utils/log.h"
 #include "core/utils/unit.h"
+#include "tools/field_reduction.h"
 
 using namespace allpix;
 
@@ -86,8 +87,69 @@ void ElectricFieldReaderModule::initialize() {
 
         auto field_data = read_field(thickness_domain, field_scale);
 
-        detector_->setElectricFieldGrid(
-            field_data.getData(), field_data.getDimensions(), field_scale, field_offset, thickness_domain);
+        // Reduce the field grid if the field does not change along x and/or y:
+        std::array<bool, 2> reduced_axes{};
+        if(config_.get<bool>("reduce_field_dimensions", false)) {
+            reduced_axes =
+                find_invariant_axes(field_data, FieldQuantity::VECTOR, config_.get<double>("reduction_tolerance", 1e-6));
+            if(reduced_axes[0] || reduced_axes[1]) {
+                field_data = collapse_axes(field_data, FieldQuantity::VECTOR, reduced_axes);
+                LOG(INFO) << "Electric field is invariant along" << (reduced_axes[0] ? " x" : "")
+                          << (reduced_axes[1] ? " y" : "") << ", reduced to " << field_data.getDimensions().at(0) << "x"
+                          << field_data.getDimensions().at(1) << "x" << field_data.getDimensions().at(2) << " cells";
+            }
+        }
+
+        // Only store the upper half or quadrant of the field if it is symmetric with respect to the center of the field:
+        auto dimensions = field_data.getDimensions();
+        auto full_field = field_data;
+        std::array<bool, 2> mirrored_axes{};
+        if(config_.get<bool>("mirror_symmetry", false)) {
+            mirrored_axes =
+                find_symmetric_axes(field_data, FieldQuantity::VECTOR, config_.get<double>("symmetry_tolerance", 1e-6));
+            for(size_t axis = 0; axis < 2; ++axis) {
+                if(dimensions.at(axis) > 1 && !mirrored_axes.at(axis)) {
+                    throw InvalidValueError(config_,
+                                            "mirror_symmetry",
+                                            std::string("electric field is not mirror-symmetric along ") +
+                                                (axis == 0 ? "x" : "y") + " within the configured tolerance");
+                }
+            }
+            field_data = mirror_axes(field_data, FieldQuantity::VECTOR, mirrored_axes);
+            LOG(INFO) << "Electric field is mirror-symmetric, storing " << field_data.getDimensions().at(0) << "x"
+                      << field_data.getDimensions().at(1) << "x" << field_data.getDimensions().at(2) << " cells";
+        }
+
+        detector_->setElectricFieldGrid(field_data.getData(),
+                                        dimensions,
+                                        field_scale,
+                                        field_offset,
+                                        thickness_domain,
+                                        reduced_axes,
+                                        mirrored_axes);
+
+        // Verify that lookups in all quadrants of a mirrored field reproduce the full field:
+        if(mirrored_axes[0] || mirrored_axes[1]) {
+            auto pitch = model->getPixelSize();
+            auto deviation = find_mirror_deviation(
+                full_field,
+                FieldQuantity::VECTOR,
+                {{field_scale[0] * pitch.x(), field_scale[1] * pitch.y()}},
+                thickness_domain,
+                [&](double x, double y, double z) {
+                    // Convert from the center of the field to local coordinates of the first field replica:
+                    return detector_->getElectricField(
+                        ROOT::Math::XYZPoint(x - field_offset[0] + 0.5 * (field_scale[0] - 1) * pitch.x(),
+                                             y - field_offset[1] + 0.5 * (field_scale[1] - 1) * pitch.y(),
+                                             z));
+                });
+            if(deviation > config_.get<double>("symmetry_tolerance", 1e-6)) {
+                LOG(WARNING) << "Lookups of the mirrored electric field deviate from the full field by up to "
+                             << deviation << " of its maximum value";
+            } else {
+                LOG(DEBUG) << "Lookups of the mirrored electric field match the full field in all quadrants";
+            }
+        }
     } else if(field_model == ElectricField::CONSTANT) {
         LOG(TRACE) << "Adding constant electric field";
         auto field_z = config_.get<double>("bias_voltage") / getDetector()->getModel()->getSensorSize().z();
@@ -296,8 +358,9 @@ FieldData<double> ElectricFieldReaderModule::read_field(std::pair<double, double
     try {
         LOG(TRACE) << "Fetching electric field from mesh file";
 
-        // Get field from file
-        auto field_data = field_parser_.getByFileName(config_.getPath("file_name", true), "V/cm");
+        // Get field from file, storing parsed INIT files in the cache directory if requested
+        auto cache_directory = config_.has("field_cache_directory") ? config_.getPath("field_cache_directory") : "";
+        auto field_data = field_parser_.getByFileName(config_.getPath("file_name", true), "V/cm", cache_directory);
 
         // Check if electric field matches chip
         check_detector_match(field_data.getSize(), thickness_domain, field_scale);
@@ -10,6 +10,7 @@
 
 #include "GenericPropagationModule.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <map>
@@ -39,6 +40,7 @@
 #include "core/utils/unit.h"
 #include "tools/ROOT.h"
 #include "tools/runge_kutta.h"
+#include "tools/timestep_control.h"
 
 #include "objects/DepositedCharge.hpp"
 #include "objects/PropagatedCharge.hpp"
@@ -65,6 +67,8 @@ GenericPropagationModule::GenericPropagationModule(Configuration& config,
     config_.setDefault<double>("timestep_min", Units::get(0.001, "ns"));
     config_.setDefault<double>("timestep_max", Units::get(0.5, "ns"));
     config_.setDefault<double>("integration_time", Units::get(25, "ns"));
+    config_.setDefault<TimestepControl>("timestep_control", TimestepControl::SIMPLE);
+    config_.setDefault<double>("timestep_safety_factor", 0.9);
     config_.setDefault<unsigned int>("charge_per_step", 10);
     config_.setDefault<double>("temperature", 293.15);
 
@@ -83,6 +87,7 @@ GenericPropagationModule::GenericPropagationModule(Configuration& config,
     config_.setDefault<double>("output_plots_theta", 0.0f);
     config_.setDefault<double>("output_plots_phi", 0.0f);
     config_.setDefault<bool>("output_plots_lines_at_implants", false);
+    config_.setDefault<bool>("output_trajectories", false);
 
     // Set defaults for charge carrier propagation:
     config_.setDefault<bool>("propagate_electrons", true);
@@ -95,6 +100,7 @@ GenericPropagationModule::GenericPropagationModule(Configuration& config,
     }
 
     config_.setDefault<bool>("ignore_magnetic_field", false);
+    config_.setDefault<bool>("analytic_drift", false);
 
     // Copy some variables from configuration to avoid lookups:
     temperature_ = config_.get<double>("temperature");
@@ -103,22 +109,26 @@ GenericPropagationModule::GenericPropagationModule(Configuration& config,
     timestep_start_ = config_.get<double>("timestep_start");
     integration_time_ = config_.get<double>("integration_time");
     target_spatial_precision_ = config_.get<double>("spatial_precision");
+    timestep_control_ = config_.get<TimestepControl>("timestep_control");
+    timestep_safety_factor_ = config_.get<double>("timestep_safety_factor");
+    if(timestep_safety_factor_ <= 0 || timestep_safety_factor_ > 1) {
+        throw InvalidValueError(config_, "timestep_safety_factor", "safety factor has to be larger than zero and at most one");
+    }
     output_plots_ = config_.get<bool>("output_plots");
     output_linegraphs_ = config_.get<bool>("output_linegraphs");
     output_animations_ = config_.get<bool>("output_animations");
     output_plots_step_ = config_.get<double>("output_plots_step");
     output_plots_lines_at_implants_ = config_.get<bool>("output_plots_lines_at_implants");
+    output_trajectories_ = config_.get<bool>("output_trajectories");
+    record_trajectories_ = output_linegraphs_ || output_trajectories_;
     propagate_electrons_ = config_.get<bool>("propagate_electrons");
     propagate_holes_ = config_.get<bool>("propagate_holes");
     charge_per_step_ = config_.get<unsigned int>("charge_per_step");
+    analytic_drift_ = config_.get<bool>("analytic_drift");
 
-    // Enable multithreading of this module if multithreading is enabled and no per-event output plots are requested:
-    // FIXME: Review if this is really the case or we can still use multithreading
-    if(!(output_animations_ || output_linegraphs_)) {
-        allow_multithreading();
-    } else {
-        LOG(WARNING) << "Per-event line graphs or animations requested, disabling parallel event processing";
-    }
+    // Enable multithreading of this module if multithreading is enabled, per-event line graphs and animations are only
+    // rendered in finalize()
+    allow_multithreading();
 
     boltzmann_kT_ = Units::get(8.6173e-5, "eV/K") * temperature_;
 
@@ -543,6 +553,13 @@ void GenericPropagationModule::initialize() {
                                   100,
                                   0,
                                   1);
+
+        steps_per_group_histo_ =
+            CreateHistogram<TH1D>("steps_per_group_histo",
+                                  "Integration steps per charge carrier group;integration steps;number of groups transported",
+                                  100,
+                                  0,
+                                  10 * integration_time_ / timestep_max_);
     }
 
     // Prepare mobility model
@@ -558,6 +575,139 @@ void GenericPropagationModule::initialize() {
     } catch(ModelError& e) {
         throw InvalidValueError(config_, "recombination_model", e.what());
     }
+
+    // Tabulate the drift velocity if analytic drift integration is requested and the electric field only depends on depth
+    if(analytic_drift_) {
+        auto field_type = detector->getElectricFieldType();
+        if((field_type != FieldType::CONSTANT && field_type != FieldType::LINEAR) || detector->hasDopingProfile()) {
+            LOG(WARNING) << "Analytic drift integration requires a constant or linear electric field and no doping profile, "
+                            "falling back to Runge-Kutta integration";
+            analytic_drift_ = false;
+        } else {
+            if(propagate_electrons_) {
+                create_drift_table(CarrierType::ELECTRON);
+            }
+            if(propagate_holes_) {
+                create_drift_table(CarrierType::HOLE);
+            }
+            LOG(INFO) << "Using analytic drift integration in " << (field_type == FieldType::LINEAR ? "linear" : "constant")
+                      << " electric field with time steps of " << Units::display(timestep_max_, {"ps", "ns"});
+        }
+    }
+}
+
+Eigen::Vector3d
+GenericPropagationModule::carrier_velocity(const CarrierType& type, const Eigen::Vector3d& efield, double doping) const {
+    if(!has_magnetic_field_) {
+        return static_cast<int>(type) * mobility_(type, efield.norm(), doping) * efield;
+    }
+
+    Eigen::Vector3d bfield(magnetic_field_.x(), magnetic_field_.y(), magnetic_field_.z());
+
+    auto mob = mobility_(type, efield.norm(), doping);
+    auto exb = efield.cross(bfield);
+
+    Eigen::Vector3d term1;
+    double hallFactor = (type == CarrierType::ELECTRON ? electron_Hall_ : hole_Hall_);
+    term1 = static_cast<int>(type) * mob * hallFactor * exb;
+
+    Eigen::Vector3d term2 = mob * mob * hallFactor * hallFactor * efield.dot(bfield) * bfield;
+
+    auto rnorm = 1 + mob * mob * hallFactor * hallFactor * bfield.dot(bfield);
+    return static_cast<int>(type) * mob * (efield + term1 + term2) / rnorm;
+}
+
+/**
+ * The drift velocity is evaluated at the center of the sensor in x and y, in equidistant points along the full sensor
+ * thickness. This is only valid for fields which do not change in x and y and without a doping profile.
+ */
+void GenericPropagationModule::create_drift_table(const CarrierType& type) {
+    // Number of intervals the sensor thickness is divided into:
+    const size_t bins = 1000;
+    drift_table_z_min_ = model_->getSensorCenter().z() - model_->getSensorSize().z() / 2.0;
+    drift_table_bin_width_ = model_->getSensorSize().z() / static_cast<double>(bins);
+
+    auto& table = drift_table_[type];
+    table.clear();
+    for(size_t i = 0; i <= bins; ++i) {
+        auto point = ROOT::Math::XYZPoint(model_->getSensorCenter().x(),
+                                          model_->getSensorCenter().y(),
+                                          drift_table_z_min_ + static_cast<double>(i) * drift_table_bin_width_);
+        auto raw_field = detector_->getElectricField(point);
+        Eigen::Vector3d efield(raw_field.x(), raw_field.y(), raw_field.z());
+        table.push_back(carrier_velocity(type, efield, 0.));
+    }
+}
+
+/**
+ * Within every interval of the table, the velocity along z depends linearly on z, \f$v_z = v_0 + g u\f$ with the distance
+ * \f$u\f$ from the lower edge of the interval. The motion along z is then given by \f$v_z(t) = v_z(0) e^{g t}\f$, and the
+ * motion in x and y follows from integrating their linearly interpolated velocity components along this path. The result is
+ * exact for the interpolated velocity only, the interpolation itself is an approximation of the drift velocity. Carriers
+ * leaving the tabulated range continue with the velocity at the respective edge of the sensor.
+ */
+void GenericPropagationModule::drift_analytic(const CarrierType& type, Eigen::Vector3d& position, double timestep) const {
+    const auto& table = drift_table_.at(type);
+    const auto bins = static_cast<long>(table.size()) - 1;
+
+    auto index = static_cast<long>(std::floor((position.z() - drift_table_z_min_) / drift_table_bin_width_));
+    double remaining = timestep;
+    while(remaining > 0) {
+        if(index < 0 || index >= bins) {
+            position += remaining * (index < 0 ? table.front() : table.back());
+            return;
+        }
+
+        const auto& velocity_low = table[static_cast<size_t>(index)];
+        Eigen::Vector3d gradient = (table[static_cast<size_t>(index) + 1] - velocity_low) / drift_table_bin_width_;
+        auto z_low = drift_table_z_min_ + static_cast<double>(index) * drift_table_bin_width_;
+        auto u_start = std::clamp(position.z() - z_low, 0., drift_table_bin_width_);
+        auto vz_start = velocity_low.z() + gradient.z() * u_start;
+
+        // Without drift along z, the velocity stays constant:
+        if(vz_start == 0.) {
+            position.x() += remaining * (velocity_low.x() + gradient.x() * u_start);
+            position.y() += remaining * (velocity_low.y() + gradient.y() * u_start);
+            return;
+        }
+
+        // Determine the time needed to leave the interval in the direction of motion, if it is left at all
+        auto u_exit = (vz_start > 0 ? drift_table_bin_width_ : 0.);
+        auto vz_exit = velocity_low.z() + gradient.z() * u_exit;
+        auto linear_time = (u_exit - u_start) / vz_start;
+        auto constant_velocity = std::fabs(gradient.z() * linear_time) < 1e-9;
+        double exit_time = std::numeric_limits<double>::infinity();
+        if(constant_velocity) {
+            exit_time = linear_time;
+        } else if(vz_exit / vz_start > 0) {
+            exit_time = std::log(vz_exit / vz_start) / gradient.z();
+        }
+
+        // Move to the exit point or as far as the remaining time allows
+        auto dt = std::min(remaining, exit_time);
+        double u_end = 0, u_integral = 0;
+        if(dt == exit_time) {
+            u_end = u_exit;
+        } else if(constant_velocity) {
+            u_end = u_start + vz_start * dt;
+        } else {
+            u_end = (vz_start * std::exp(gradient.z() * dt) - velocity_low.z()) / gradient.z();
+        }
+        if(constant_velocity) {
+            u_integral = u_start * dt + 0.5 * vz_start * dt * dt;
+        } else {
+            u_integral = (u_end - u_start - velocity_low.z() * dt) / gradient.z();
+        }
+
+        position.x() += velocity_low.x() * dt + gradient.x() * u_integral;
+        position.y() += velocity_low.y() * dt + gradient.y() * u_integral;
+        position.z() = z_low + u_end;
+
+        remaining -= dt;
+        if(dt == exit_time) {
+            index += (vz_start > 0 ? 1 : -1);
+        }
+    }
 }
 
 void GenericPropagationModule::run(Event* event) {
@@ -566,8 +716,9 @@ void GenericPropagationModule::run(Event* event) {
     // Create vector of propagated charges to output
     std::vector<PropagatedCharge> propagated_charges;
 
-    // List of points to plot to plot for output plots
+    // List of points to plot for output plots and list of trajectories to output
     OutputPlotPoints output_plot_points;
+    std::vector<CarrierTrajectory> trajectories;
 
     // Loop over all deposits for propagation
     LOG(TRACE) << "Propagating charges in sensor";
@@ -609,22 +760,53 @@ void GenericPropagationModule::run(Event* event) {
             // Get position and propagate through sensor
             auto initial_position = deposit.getLocalPosition();
 
-            // Add point of deposition to the output plots if requested
+            // Propagate a single charge deposit
+            std::vector<ROOT::Math::XYZPoint> trajectory_points;
+            std::vector<double> trajectory_times;
+            auto [final_position, time, alive, integration_steps, rejected_steps] =
+                propagate(initial_position,
+                          deposit.getType(),
+                          deposit.getLocalTime(),
+                          event->getRandomEngine(),
+                          trajectory_points,
+                          trajectory_times);
+
+            // Update statistics of the integration steps
+            ++total_groups_;
+            total_integration_steps_ += integration_steps;
+            total_rejected_steps_ += rejected_steps;
+            if(output_plots_) {
+                steps_per_group_histo_->Fill(integration_steps);
+            }
+
+            // Store the trajectory of this set of charges for the output plots if requested
             if(output_linegraphs_) {
-                auto global_position = detector_->getGlobalPosition(initial_position);
-                std::lock_guard<std::mutex> lock{stats_mutex_};
-                output_plot_points.emplace_back(PropagatedCharge(initial_position,
-                                                                 global_position,
-                                                                 deposit.getType(),
-                                                                 charge_per_step,
-                                                                 deposit.getLocalTime(),
-                                                                 deposit.getGlobalTime()),
-                                                std::vector<ROOT::Math::XYZPoint>());
+                // Only keep lines from charge carriers that reached the implant side within the integration time if requested
+                auto drift_time = time - deposit.getLocalTime();
+                if(!output_plots_lines_at_implants_ ||
+                   (drift_time < integration_time_ && final_position.z() >= -model_->getSensorSize().z() * 0.45)) {
+                    output_plot_points.emplace_back(PropagatedCharge(initial_position,
+                                                                     detector_->getGlobalPosition(initial_position),
+                                                                     deposit.getType(),
+                                                                     charge_per_step,
+                                                                     deposit.getLocalTime(),
+                                                                     deposit.getGlobalTime()),
+                                                    trajectory_points);
+                }
             }
 
-            // Propagate a single charge deposit
-            auto [final_position, time, alive] = propagate(
-                initial_position, deposit.getType(), deposit.getLocalTime(), event->getRandomEngine(), output_plot_points);
+            // Create the trajectory object if requested
+            if(output_trajectories_) {
+                trajectories.emplace_back(initial_position,
+                                          detector_->getGlobalPosition(initial_position),
+                                          deposit.getType(),
+                                          charge_per_step,
+                                          deposit.getLocalTime(),
+                                          deposit.getGlobalTime(),
+                                          std::move(trajectory_points),
+                                          std::move(trajectory_times),
+                                          &deposit);
+            }
 
             if(!alive) {
                 LOG(DEBUG) << " Recombined " << charge_per_step << " at " << Units::display(final_position, {"mm", "um"})
@@ -659,9 +841,10 @@ void GenericPropagationModule::run(Event* event) {
         }
     }
 
-    // Output plots if required
+    // Store points for output plots if required, they are rendered at the end of the run to allow parallel processing
     if(output_linegraphs_) {
-        create_output_plots(event->number, output_plot_points);
+        std::lock_guard<std::mutex> lock{plot_points_mutex_};
+        output_plot_points_.emplace(event->number, std::move(output_plot_points));
     }
 
     // Write summary and update statistics
@@ -683,6 +866,12 @@ void GenericPropagationModule::run(Event* event) {
 
     // Dispatch the message with propagated charges
     messenger_->dispatchMessage(this, propagated_charge_message, event);
+
+    // Dispatch the message with the trajectories if requested
+    if(output_trajectories_) {
+        auto trajectory_message = std::make_shared<CarrierTrajectoryMessage>(std::move(trajectories), detector_);
+        messenger_->dispatchMessage(this, trajectory_message, event);
+    }
 }
 
 /**
@@ -690,12 +879,13 @@ void GenericPropagationModule::run(Event* event) {
  * velocity at every point with help of the electric field map of the detector. An Runge-Kutta integration is applied in
  * multiple steps, adding a random diffusion to the propagating charge every step.
  */
-std::tuple<ROOT::Math::XYZPoint, double, bool>
+std::tuple<ROOT::Math::XYZPoint, double, bool, unsigned int, unsigned int>
 GenericPropagationModule::propagate(const ROOT::Math::XYZPoint& pos,
                                     const CarrierType& type,
                                     const double initial_time,
                                     RandomNumberGenerator& random_generator,
-                                    OutputPlotPoints& output_plot_points) const {
+                                    std::vector<ROOT::Math::XYZPoint>& trajectory_points,
+                                    std::vector<double>& trajectory_times) const {
     // Create a runge kutta solver using the electric field as step function
     Eigen::Vector3d position(pos.x(), pos.y(), pos.z());
 
@@ -716,70 +906,68 @@ GenericPropagationModule::propagate(const ROOT::Math::XYZPoint& pos,
     // Survival probability of this charge carrier package, evaluated at every step
     std::uniform_real_distribution<double> survival(0, 1);
 
-    // Define lambda functions to compute the charge carrier velocity with or without magnetic field
-    std::function<Eigen::Vector3d(double, const Eigen::Vector3d&)> carrier_velocity_noB =
-        [&](double, const Eigen::Vector3d& cur_pos) -> Eigen::Vector3d {
-        auto raw_field = detector_->getElectricField(static_cast<ROOT::Math::XYZPoint>(cur_pos));
-        Eigen::Vector3d efield(raw_field.x(), raw_field.y(), raw_field.z());
-        auto doping = detector_->getDopingConcentration(static_cast<ROOT::Math::XYZPoint>(cur_pos));
-
-        return static_cast<int>(type) * mobility_(type, efield.norm(), doping) * efield;
-    };
-
-    std::function<Eigen::Vector3d(double, const Eigen::Vector3d&)> carrier_velocity_withB =
+    // Define a lambda function to compute the charge carrier velocity, with or without magnetic field
+    std::function<Eigen::Vector3d(double, const Eigen::Vector3d&)> velocity_function =
         [&](double, const Eigen::Vector3d& cur_pos) -> Eigen::Vector3d {
         auto raw_field = detector_->getElectricField(static_cast<ROOT::Math::XYZPoint>(cur_pos));
         Eigen::Vector3d efield(raw_field.x(), raw_field.y(), raw_field.z());
-
-        Eigen::Vector3d velocity;
-        Eigen::Vector3d bfield(magnetic_field_.x(), magnetic_field_.y(), magnetic_field_.z());
-
         auto doping = detector_->getDopingConcentration(static_cast<ROOT::Math::XYZPoint>(cur_pos));
 
-        auto mob = mobility_(type, efield.norm(), doping);
-        auto exb = efield.cross(bfield);
-
-        Eigen::Vector3d term1;
-        double hallFactor = (type == CarrierType::ELECTRON ? electron_Hall_ : hole_Hall_);
-        term1 = static_cast<int>(type) * mob * hallFactor * exb;
-
-        Eigen::Vector3d term2 = mob * mob * hallFactor * hallFactor * efield.dot(bfield) * bfield;
-
-        auto rnorm = 1 + mob * mob * hallFactor * hallFactor * bfield.dot(bfield);
-        return static_cast<int>(type) * mob * (efield + term1 + term2) / rnorm;
+        return carrier_velocity(type, efield, doping);
     };
 
-    // Create the runge kutta solver with an RKF5 tableau, using different velocity calculators depending on the magnetic
-    // field
-    auto runge_kutta = make_runge_kutta(
-        tableau::RK5, (has_magnetic_field_ ? carrier_velocity_withB : carrier_velocity_noB), timestep_start_, position);
+    // Create the runge kutta solver with an RKF5 tableau
+    auto runge_kutta = make_runge_kutta(tableau::RK5, velocity_function, timestep_start_, position);
 
     // Continue propagation until the deposit is outside the sensor
     Eigen::Vector3d last_position = position;
     double last_time = 0;
+    double current_time = 0;
     size_t next_idx = 0;
     bool is_alive = true;
+    unsigned int integration_steps = 0;
+    PITimestepController timestep_control(target_spatial_precision_, timestep_safety_factor_, timestep_min_, timestep_max_);
     while(detector_->getModel()->isWithinSensor(static_cast<ROOT::Math::XYZPoint>(position)) &&
-          (initial_time + runge_kutta.getTime()) < integration_time_ && is_alive) {
-        // Update output plots if necessary (depending on the plot step)
-        if(output_linegraphs_) {
-            auto time_idx = static_cast<size_t>(runge_kutta.getTime() / output_plots_step_);
+          (initial_time + current_time) < integration_time_ && is_alive) {
+        // Update trajectory if necessary (depending on the plot step)
+        if(record_trajectories_) {
+            auto time_idx = static_cast<size_t>(current_time / output_plots_step_);
             while(next_idx <= time_idx) {
-                output_plot_points.back().second.push_back(static_cast<ROOT::Math::XYZPoint>(position));
-                next_idx = output_plot_points.back().second.size();
+                trajectory_points.push_back(static_cast<ROOT::Math::XYZPoint>(position));
+                trajectory_times.push_back(static_cast<double>(next_idx) * output_plots_step_);
+                next_idx = trajectory_points.size();
             }
         }
 
         // Save previous position and time
         last_position = position;
-        last_time = runge_kutta.getTime();
-
-        // Execute a Runge Kutta step
-        auto step = runge_kutta.step();
+        last_time = current_time;
+
+        double timestep = timestep_max_;
+        decltype(runge_kutta.step()) step;
+        if(analytic_drift_) {
+            // Drift along the tabulated velocity profile using the maximum timestep
+            drift_analytic(type, position, timestep);
+            current_time += timestep;
+        } else {
+            // Execute a Runge Kutta step
+            step = runge_kutta.step();
+            timestep = runge_kutta.getTimeStep();
+
+            // Reject steps exceeding the target precision unless the minimum timestep has been reached already
+            if(timestep_control_ == TimestepControl::PI && timestep_control.reject(step.error.norm(), timestep)) {
+                ++integration_steps;
+                runge_kutta.setValue(last_position);
+                runge_kutta.setTime(last_time);
+                runge_kutta.setTimeStep(timestep);
+                continue;
+            }
 
-        // Get the current result and timestep
-        auto timestep = runge_kutta.getTimeStep();
-        position = runge_kutta.getValue();
+            // Get the current result and timestep
+            position = runge_kutta.getValue();
+            current_time = runge_kutta.getTime();
+        }
+        ++integration_steps;
 
         // Get electric field at current position and fall back to empty field if it does not exist
         auto efield = detector_->getElectricField(static_cast<ROOT::Math::XYZPoint>(position));
@@ -788,7 +976,6 @@ GenericPropagationModule::propagate(const ROOT::Math::XYZPoint& pos,
         // Apply diffusion step
         auto diffusion = carrier_diffusion(std::sqrt(efield.Mag2()), doping, timestep);
         position += diffusion;
-        runge_kutta.setValue(position);
 
         // Check if charge carrier is still alive:
         is_alive = !recombination_(type,
@@ -798,8 +985,15 @@ GenericPropagationModule::propagate(const ROOT::Math::XYZPoint& pos,
 
         LOG(TRACE) << "Step from " << Units::display(static_cast<ROOT::Math::XYZPoint>(last_position), {"um", "mm"})
                    << " to " << Units::display(static_cast<ROOT::Math::XYZPoint>(position), {"um", "mm"}) << " at "
-                   << Units::display(initial_time + runge_kutta.getTime(), {"ps", "ns", "us"})
+                   << Units::display(initial_time + current_time, {"ps", "ns", "us"})
                    << (is_alive ? "" : ", recombined");
+
+        // The analytic drift does not require any step size adaptation
+        if(analytic_drift_) {
+            continue;
+        }
+        runge_kutta.setValue(position);
+
         // Adapt step size to match target precision
         double uncertainty = step.error.norm();
 
@@ -809,8 +1003,29 @@ GenericPropagationModule::propagate(const ROOT::Math::XYZPoint& pos,
             uncertainty_histo_->Fill(static_cast<double>(Units::convert(step.error.norm(), "nm")));
         }
 
-        // Lower timestep when reaching the sensor edge
-        if(std::fabs(model_->getSensorSize().z() / 2.0 - position.z()) < 2 * step.value.z()) {
+        if(timestep_control_ == TimestepControl::PI) {
+            auto next_timestep = timestep_control.next(uncertainty, timestep);
+
+            // Stop the charge carrier on the implant side once it would reach it within the minimum timestep
+            auto distance = model_->getSensorSize().z() / 2.0 - position.z();
+            auto velocity_z = step.value.z() / timestep;
+            if(velocity_z > 0 && distance >= 0 && distance <= velocity_z * timestep_min_) {
+                position.z() = model_->getSensorSize().z() / 2.0;
+                current_time += distance / velocity_z;
+                LOG(DEBUG) << "Charge carrier reached the implant side at "
+                           << Units::display(static_cast<ROOT::Math::XYZPoint>(position), {"um", "mm"}) << " after "
+                           << integration_steps << " integration steps";
+                break;
+            }
+
+            // Do not drift beyond the implant side in the next step to ensure a precise end point, but never go below the
+            // minimum timestep to not stall the propagation close to the implant
+            timestep = next_timestep;
+            if(velocity_z > 0) {
+                timestep = std::max(std::min(timestep, distance / velocity_z), timestep_min_);
+            }
+        } else if(std::fabs(model_->getSensorSize().z() / 2.0 - position.z()) < 2 * step.value.z()) {
+            // Lower timestep when reaching the sensor edge
             timestep *= 0.75;
         } else {
             if(uncertainty > target_spatial_precision_) {
@@ -829,7 +1044,7 @@ GenericPropagationModule::propagate(const ROOT::Math::XYZPoint& pos,
     }
 
     // Find proper final position in the sensor
-    auto time = runge_kutta.getTime();
+    auto time = current_time;
     if(!detector_->getModel()->isWithinSensor(static_cast<ROOT::Math::XYZPoint>(position))) {
         auto check_position = position;
         check_position.z() = last_position.z();
@@ -847,33 +1062,40 @@ GenericPropagationModule::propagate(const ROOT::Math::XYZPoint& pos,
         }
     }
 
-    // If requested, remove charge drift lines from plots if they did not reach the implant side within the integration time:
-    if(output_linegraphs_ && output_plots_lines_at_implants_) {
-        // If drift time is larger than integration time or the charge carriers have been collected at the backside, remove
-        if(time >= integration_time_ || last_position.z() < -model_->getSensorSize().z() * 0.45) {
-            output_plot_points.pop_back();
-        }
-    }
-
     if(!is_alive) {
         LOG(DEBUG) << "Charge carrier recombined after " << Units::display(last_time, {"ns"});
     }
 
     // Return the final position of the propagated charge
-    return std::make_tuple(static_cast<ROOT::Math::XYZPoint>(position), initial_time + time, is_alive);
+    return std::make_tuple(static_cast<ROOT::Math::XYZPoint>(position),
+                           initial_time + time,
+                           is_alive,
+                           integration_steps,
+                           timestep_control.getRejectedSteps());
 }
 
 void GenericPropagationModule::finalize() {
+    // Render line graphs and animations of all events in order of the event number
+    for(auto& [event_num, output_plot_points] : output_plot_points_) {
+        create_output_plots(event_num, output_plot_points);
+    }
+    output_plot_points_.clear();
+
     if(output_plots_) {
         step_length_histo_->Write();
         drift_time_histo_->Write();
         uncertainty_histo_->Write();
         group_size_histo_->Write();
         recombine_histo_->Write();
+        steps_per_group_histo_->Write();
     }
 
     long double average_time = static_cast<long double>(total_time_picoseconds_) / 1e3 /
                                std::max(1u, static_cast<unsigned int>(total_propagated_charges_));
     LOG(INFO) << "Propagated total of " << total_propagated_charges_ << " charges in " << total_steps_
               << " steps in average time of " << Units::display(average_time, "ns");
+
+    if(timestep_control_ == TimestepControl::PI) {
+        log_timestep_statistics(total_groups_, total_integration_steps_, total_rejected_steps_);
+    }
 }
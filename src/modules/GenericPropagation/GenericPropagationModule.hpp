@@ -8,11 +8,14 @@
  */
 
 #include <atomic>
+#include <map>
 #include <memory>
 #include <random>
 #include <string>
 #include <vector>
 
+#include <Eigen/Core>
+
 #include <Math/Point3D.h>
 #include <TFile.h>
 #include <TH1D.h>
@@ -23,6 +26,7 @@
 #include "core/module/Event.hpp"
 #include "core/module/Module.hpp"
 
+#include "objects/CarrierTrajectory.hpp"
 #include "objects/DepositedCharge.hpp"
 #include "objects/PropagatedCharge.hpp"
 
@@ -45,6 +49,14 @@ namespace allpix {
      * each other and are threated fully separate, allowing for a speed-up by propagating the charges in multiple threads.
      */
     class GenericPropagationModule : public Module {
+        /**
+         * @brief Methods to adapt the time step of the Runge-Kutta integration
+         */
+        enum class TimestepControl {
+            SIMPLE, ///< Scale the time step by fixed factors depending on the error of the last step
+            PI,     ///< Proportional-integral controller with rejection of steps exceeding the target precision
+        };
+
     public:
         /**
          * @brief Constructor for this detector-specific module
@@ -65,7 +77,7 @@ namespace allpix {
         void run(Event*) override;
 
         /**
-         * @brief Write statistical summary
+         * @brief Render line graphs and animations of all events and write statistical summary
          */
         void finalize() override;
 
@@ -75,32 +87,64 @@ namespace allpix {
         std::shared_ptr<DetectorModel> model_;
 
         /**
-         * @brief Create output plots in every event
+         * @brief Create output plots for a single event
          * @param event_num Index for this event
          * @param output_plot_points List of points cached for plotting
          */
         void create_output_plots(uint64_t event_num, OutputPlotPoints& output_plot_points);
 
+        /**
+         * @brief Calculate the drift velocity of a charge carrier
+         * @param type Type of the charge carrier
+         * @param efield Electric field at the position of the carrier
+         * @param doping Doping concentration at the position of the carrier
+         * @return Drift velocity of the carrier, including the Lorentz drift if a magnetic field is present
+         */
+        Eigen::Vector3d carrier_velocity(const CarrierType& type, const Eigen::Vector3d& efield, double doping) const;
+
+        /**
+         * @brief Tabulate the drift velocity along the sensor thickness for fields which only depend on the depth
+         * @param type Type of the carrier to tabulate the drift velocity for
+         */
+        void create_drift_table(const CarrierType& type);
+
+        /**
+         * @brief Move a charge carrier along the tabulated drift velocity profile
+         * @param type Type of the charge carrier
+         * @param position Position of the charge carrier, updated to the position after the drift
+         * @param timestep Time span of the drift
+         *
+         * The velocity is interpolated linearly between the tabulated points, the motion within every interval of the table
+         * is then integrated exactly.
+         */
+        void drift_analytic(const CarrierType& type, Eigen::Vector3d& position, double timestep) const;
+
         /**
          * @brief Propagate a single set of charges through the sensor
          * @param pos Position of the deposit in the sensor
          * @param type Type of the carrier to propagate
          * @param initial_time Initial time passed before propagation starts in local time coordinates
          * @param random_generator Reference to the random number engine to be used
-         * @param output_plot_points Reference to vector to hold points for line graph output plots
-         * @return Tuple with the point where the deposit ended after propagation, the time the propagation took and a flag
-         * whether it has recombined
+         * @param trajectory_points Reference to vector to hold the sampled trajectory, only filled if requested
+         * @param trajectory_times Reference to vector to hold the propagation time of the sampled trajectory points
+         * @return Tuple with the point where the deposit ended after propagation, the time the propagation took, a flag
+         * whether it has recombined, the number of integration steps and the number of rejected integration steps
          */
-        std::tuple<ROOT::Math::XYZPoint, double, bool> propagate(const ROOT::Math::XYZPoint& pos,
-                                                                 const CarrierType& type,
-                                                                 const double initial_time,
-                                                                 RandomNumberGenerator& random_generator,
-                                                                 OutputPlotPoints& output_plot_points) const;
+        std::tuple<ROOT::Math::XYZPoint, double, bool, unsigned int, unsigned int>
+        propagate(const ROOT::Math::XYZPoint& pos,
+                  const CarrierType& type,
+                  const double initial_time,
+                  RandomNumberGenerator& random_generator,
+                  std::vector<ROOT::Math::XYZPoint>& trajectory_points,
+                  std::vector<double>& trajectory_times) const;
 
         // Local copies of configuration parameters to avoid costly lookup:
         double temperature_{}, timestep_min_{}, timestep_max_{}, timestep_start_{}, integration_time_{},
-            target_spatial_precision_{}, output_plots_step_{};
+            target_spatial_precision_{}, output_plots_step_{}, timestep_safety_factor_{};
+        TimestepControl timestep_control_{};
         bool output_plots_{}, output_linegraphs_{}, output_animations_{}, output_plots_lines_at_implants_{};
+        bool output_trajectories_{}, record_trajectories_{};
+        bool analytic_drift_{};
         bool propagate_electrons_{}, propagate_holes_{};
         unsigned int charge_per_step_{};
 
@@ -119,16 +163,27 @@ namespace allpix {
         bool has_magnetic_field_;
         ROOT::Math::XYZVector magnetic_field_;
 
+        // Drift velocity tabulated along the sensor thickness for the analytic drift integration
+        std::map<CarrierType, std::vector<Eigen::Vector3d>> drift_table_;
+        double drift_table_z_min_{}, drift_table_bin_width_{};
+
         // Statistical information
         std::atomic<unsigned int> total_propagated_charges_{};
         std::atomic<unsigned int> total_steps_{};
         std::atomic<long unsigned int> total_time_picoseconds_{};
+        std::atomic<long unsigned int> total_groups_{};
+        std::atomic<long unsigned int> total_integration_steps_{};
+        std::atomic<long unsigned int> total_rejected_steps_{};
         Histogram<TH1D> step_length_histo_;
         Histogram<TH1D> drift_time_histo_;
         Histogram<TH1D> uncertainty_histo_;
         Histogram<TH1D> group_size_histo_;
         Histogram<TH1D> recombine_histo_;
-        std::mutex stats_mutex_;
+        Histogram<TH1D> steps_per_group_histo_;
+
+        // Points for line graphs and animations, collected per event and rendered at the end of the run
+        std::map<uint64_t, OutputPlotPoints> output_plot_points_;
+        std::mutex plot_points_mutex_;
     };
 
 } // namespace allpix
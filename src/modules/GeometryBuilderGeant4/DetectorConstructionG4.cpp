@@ -21,6 +21,7 @@
 #include <G4NistManager.hh>
 #include <G4PVDivision.hh>
 #include <G4PVPlacement.hh>
+#include <G4PVReplica.hh>
 #include <G4PhysicalVolumeStore.hh>
 #include <G4Sphere.hh>
 #include <G4StepLimiterPhysics.hh>
@@ -306,48 +307,153 @@ void DetectorConstructionG4::build(const std::shared_ptr<G4LogicalVolume>& world
                                                                            true);
             geo_manager_->setExternalObject(name, "bumps_wrapper_phys", bumps_wrapper_phys);
 
-            // Create the individual bump solid
-            auto bump_sphere = make_shared_no_delete<G4Sphere>(
-                "bumps_" + name + "_sphere", 0, bump_sphere_radius, 0, 360 * CLHEP::deg, 0, 360 * CLHEP::deg);
-            solids_.push_back(bump_sphere);
-            auto bump_tube = make_shared_no_delete<G4Tubs>(
-                "bumps_" + name + "_tube", 0., bump_cylinder_radius, bump_height / 2., 0., 360 * CLHEP::deg);
-            solids_.push_back(bump_tube);
-            auto bump = make_shared_no_delete<G4UnionSolid>("bumps_" + name, bump_sphere.get(), bump_tube.get());
-            solids_.push_back(bump);
-
-            // Create the logical volume for the individual bumps
-            auto bumps_cell_log =
-                make_shared_no_delete<G4LogicalVolume>(bump.get(), materials.get("solder"), "bumps_" + name + "_log");
-            geo_manager_->setExternalObject(name, "bumps_cell_log", bumps_cell_log);
-
             // Add bump material equivalent to uniform solder layer to total material budget:
+            auto* solder = materials.get("solder");
             auto radius = std::max(hybrid_model->getBumpSphereRadius(), hybrid_model->getBumpCylinderRadius());
             auto relativeArea = M_PI * radius * radius / model->getPixelSize().x() / model->getPixelSize().y();
-            total_material_budget +=
-                (relativeArea * hybrid_model->getBumpHeight() / bumps_cell_log->GetMaterial()->GetRadlen());
-
-            // Place the bump bonds grid
-            std::shared_ptr<G4VPVParameterisation> bumps_param = std::make_shared<Parameterization2DG4>(
-                hybrid_model->getNPixels().x(),
-                hybrid_model->getPixelSize().x(),
-                hybrid_model->getPixelSize().y(),
-                -(hybrid_model->getNPixels().x() * hybrid_model->getPixelSize().x()) / 2.0 +
-                    (hybrid_model->getBumpsCenter().x() - hybrid_model->getCenter().x()),
-                -(hybrid_model->getNPixels().y() * hybrid_model->getPixelSize().y()) / 2.0 +
-                    (hybrid_model->getBumpsCenter().y() - hybrid_model->getCenter().y()),
-                0);
-            geo_manager_->setExternalObject(name, "bumps_param", bumps_param);
-
-            std::shared_ptr<G4PVParameterised> bumps_param_phys =
-                std::make_shared<ParameterisedG4>("bumps_" + name + "_phys",
-                                                  bumps_cell_log.get(),
-                                                  bumps_wrapper_log.get(),
-                                                  kUndefined,
-                                                  hybrid_model->getNPixels().x() * hybrid_model->getNPixels().y(),
-                                                  bumps_param.get(),
-                                                  false);
-            geo_manager_->setExternalObject(name, "bumps_param_phys", bumps_param_phys);
+            total_material_budget += (relativeArea * hybrid_model->getBumpHeight() / solder->GetRadlen());
+
+            // Size and center of the bump bond grid in the wrapper volume
+            auto bumps_grid_size_x = hybrid_model->getNPixels().x() * hybrid_model->getPixelSize().x();
+            auto bumps_grid_size_y = hybrid_model->getNPixels().y() * hybrid_model->getPixelSize().y();
+            G4ThreeVector bumps_grid_pos(hybrid_model->getBumpsCenter().x() - hybrid_model->getCenter().x(),
+                                         hybrid_model->getBumpsCenter().y() - hybrid_model->getCenter().y(),
+                                         0);
+
+            auto bump_geometry = hybrid_model->getBumpGeometry();
+            if(bump_geometry == HybridPixelDetectorModel::BumpGeometry::LAYER) {
+                // Dilute the solder to the fraction of the pixel area covered by a bump to conserve the material budget
+                auto fill_fraction = std::min(relativeArea, 1.0);
+                LOG(DEBUG) << "Representing bump bonds of detector " << name
+                           << " as homogeneous solder layer with fill fraction " << fill_fraction;
+                auto* bumps_layer_material = new G4Material("Solder_layer_" + name,
+                                                            std::max(solder->GetDensity() * fill_fraction,
+                                                                     CLHEP::universe_mean_density),
+                                                            1,
+                                                            solder->GetState(),
+                                                            solder->GetTemperature(),
+                                                            solder->GetPressure());
+                bumps_layer_material->AddMaterial(solder, 1.0);
+
+                auto bumps_layer = make_shared_no_delete<G4Box>(
+                    "bumps_" + name + "_layer", bumps_grid_size_x / 2.0, bumps_grid_size_y / 2.0, bump_height / 2.);
+                solids_.push_back(bumps_layer);
+
+                // The layer takes the place of the individual bumps for all other modules
+                auto bumps_cell_log = make_shared_no_delete<G4LogicalVolume>(
+                    bumps_layer.get(), bumps_layer_material, "bumps_" + name + "_log");
+                geo_manager_->setExternalObject(name, "bumps_cell_log", bumps_cell_log);
+
+                auto bumps_layer_phys = make_shared_no_delete<G4PVPlacement>(nullptr,
+                                                                             bumps_grid_pos,
+                                                                             bumps_cell_log.get(),
+                                                                             "bumps_" + name + "_phys",
+                                                                             bumps_wrapper_log.get(),
+                                                                             false,
+                                                                             0,
+                                                                             true);
+                geo_manager_->setExternalObject(name, "bumps_layer_phys", bumps_layer_phys);
+            } else {
+                // Create the individual bump solid
+                auto bump_sphere = make_shared_no_delete<G4Sphere>(
+                    "bumps_" + name + "_sphere", 0, bump_sphere_radius, 0, 360 * CLHEP::deg, 0, 360 * CLHEP::deg);
+                solids_.push_back(bump_sphere);
+                auto bump_tube = make_shared_no_delete<G4Tubs>(
+                    "bumps_" + name + "_tube", 0., bump_cylinder_radius, bump_height / 2., 0., 360 * CLHEP::deg);
+                solids_.push_back(bump_tube);
+                auto bump = make_shared_no_delete<G4UnionSolid>("bumps_" + name, bump_sphere.get(), bump_tube.get());
+                solids_.push_back(bump);
+
+                // Create the logical volume for the individual bumps
+                auto bumps_cell_log = make_shared_no_delete<G4LogicalVolume>(bump.get(), solder, "bumps_" + name + "_log");
+                geo_manager_->setExternalObject(name, "bumps_cell_log", bumps_cell_log);
+
+                if(bump_geometry == HybridPixelDetectorModel::BumpGeometry::REPLICA) {
+                    LOG(DEBUG) << "Representing bump bonds of detector " << name << " as replicated pixel cells";
+
+                    // Volume containing the full grid of bump bonds
+                    auto bumps_grid_box = make_shared_no_delete<G4Box>(
+                        "bumps_grid_" + name, bumps_grid_size_x / 2.0, bumps_grid_size_y / 2.0, bump_height / 2.);
+                    solids_.push_back(bumps_grid_box);
+                    auto bumps_grid_log = make_shared_no_delete<G4LogicalVolume>(
+                        bumps_grid_box.get(), materials.get("world_material"), "bumps_grid_" + name + "_log");
+                    geo_manager_->setExternalObject(name, "bumps_grid_log", bumps_grid_log);
+                    auto bumps_grid_phys = make_shared_no_delete<G4PVPlacement>(nullptr,
+                                                                                bumps_grid_pos,
+                                                                                bumps_grid_log.get(),
+                                                                                "bumps_grid_" + name + "_phys",
+                                                                                bumps_wrapper_log.get(),
+                                                                                false,
+                                                                                0,
+                                                                                true);
+                    geo_manager_->setExternalObject(name, "bumps_grid_phys", bumps_grid_phys);
+
+                    // Columns of pixel cells replicated along the x axis
+                    auto bumps_column_box = make_shared_no_delete<G4Box>("bumps_column_" + name,
+                                                                         hybrid_model->getPixelSize().x() / 2.0,
+                                                                         bumps_grid_size_y / 2.0,
+                                                                         bump_height / 2.);
+                    solids_.push_back(bumps_column_box);
+                    auto bumps_column_log = make_shared_no_delete<G4LogicalVolume>(
+                        bumps_column_box.get(), materials.get("world_material"), "bumps_column_" + name + "_log");
+                    geo_manager_->setExternalObject(name, "bumps_column_log", bumps_column_log);
+                    auto bumps_column_phys = make_shared_no_delete<G4PVReplica>("bumps_column_" + name + "_phys",
+                                                                                bumps_column_log.get(),
+                                                                                bumps_grid_log.get(),
+                                                                                kXAxis,
+                                                                                hybrid_model->getNPixels().x(),
+                                                                                hybrid_model->getPixelSize().x());
+                    geo_manager_->setExternalObject(name, "bumps_column_phys", bumps_column_phys);
+
+                    // Pixel cells replicated along the y axis in every column
+                    auto bumps_pixel_box = make_shared_no_delete<G4Box>("bumps_pixel_" + name,
+                                                                        hybrid_model->getPixelSize().x() / 2.0,
+                                                                        hybrid_model->getPixelSize().y() / 2.0,
+                                                                        bump_height / 2.);
+                    solids_.push_back(bumps_pixel_box);
+                    auto bumps_pixel_log = make_shared_no_delete<G4LogicalVolume>(
+                        bumps_pixel_box.get(), materials.get("world_material"), "bumps_pixel_" + name + "_log");
+                    geo_manager_->setExternalObject(name, "bumps_pixel_log", bumps_pixel_log);
+                    auto bumps_pixel_phys = make_shared_no_delete<G4PVReplica>("bumps_pixel_" + name + "_phys",
+                                                                               bumps_pixel_log.get(),
+                                                                               bumps_column_log.get(),
+                                                                               kYAxis,
+                                                                               hybrid_model->getNPixels().y(),
+                                                                               hybrid_model->getPixelSize().y());
+                    geo_manager_->setExternalObject(name, "bumps_pixel_phys", bumps_pixel_phys);
+
+                    // Place a single bump in the center of the pixel cell
+                    auto bumps_cell_phys = make_shared_no_delete<G4PVPlacement>(nullptr,
+                                                                                G4ThreeVector(),
+                                                                                bumps_cell_log.get(),
+                                                                                "bumps_" + name + "_phys",
+                                                                                bumps_pixel_log.get(),
+                                                                                false,
+                                                                                0,
+                                                                                false);
+                    geo_manager_->setExternalObject(name, "bumps_cell_phys", bumps_cell_phys);
+                } else {
+                    // Place the bump bonds grid
+                    std::shared_ptr<G4VPVParameterisation> bumps_param = std::make_shared<Parameterization2DG4>(
+                        hybrid_model->getNPixels().x(),
+                        hybrid_model->getPixelSize().x(),
+                        hybrid_model->getPixelSize().y(),
+                        -bumps_grid_size_x / 2.0 + bumps_grid_pos.x(),
+                        -bumps_grid_size_y / 2.0 + bumps_grid_pos.y(),
+                        0);
+                    geo_manager_->setExternalObject(name, "bumps_param", bumps_param);
+
+                    std::shared_ptr<G4PVParameterised> bumps_param_phys =
+                        std::make_shared<ParameterisedG4>("bumps_" + name + "_phys",
+                                                          bumps_cell_log.get(),
+                                                          bumps_wrapper_log.get(),
+                                                          kUndefined,
+                                                          hybrid_model->getNPixels().x() * hybrid_model->getNPixels().y(),
+                                                          bumps_param.get(),
+                                                          false);
+                    geo_manager_->setExternalObject(name, "bumps_param_phys", bumps_param_phys);
+                }
+            }
         }
 
         // ALERT: NO COVER LAYER YET
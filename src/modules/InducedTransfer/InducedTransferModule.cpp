@@ -45,6 +45,9 @@ void InducedTransferModule::initialize() {
     if(!detector_->hasWeightingPotential()) {
         throw ModuleError("This module requires a weighting potential.");
     }
+
+    // Prepare one pixel map for every thread that can run events
+    pixel_maps_.resize(ThreadPool::threadCount());
 }
 
 void InducedTransferModule::run(Event* event) {
@@ -54,7 +57,8 @@ void InducedTransferModule::run(Event* event) {
     LOG(TRACE) << "Calculating induced charge on pixels";
     bool found_electrons = false, found_holes = false;
 
-    std::map<Pixel::Index, std::vector<std::pair<double, const PropagatedCharge*>>> pixel_map;
+    auto& pixel_map = pixel_maps_[std::min<size_t>(ThreadPool::threadNum(), pixel_maps_.size() - 1)];
+    pixel_map.clear();
     for(const auto& propagated_charge : propagated_message->getData()) {
 
         // Make sure both electrons and holes are present in the input data
@@ -110,8 +114,9 @@ void InducedTransferModule::run(Event* event) {
                    << "This will cause wrong calculation of induced charge";
     }
 
-    // Create pixel charges
+    // Create pixel charges, ordered by pixel index
     LOG(TRACE) << "Combining charges at same pixel";
+    pixel_map.sort();
     std::vector<PixelCharge> pixel_charges;
     for(auto& pixel_index_charge : pixel_map) {
         double charge = 0;
@@ -8,14 +8,19 @@
  */
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "core/config/Configuration.hpp"
 #include "core/geometry/DetectorModel.hpp"
 #include "core/messenger/Messenger.hpp"
 #include "core/module/Module.hpp"
+#include "core/module/ThreadPool.hpp"
 
 #include "objects/PropagatedCharge.hpp"
 
+#include "tools/pixel_map.h"
+
 namespace allpix {
     /**
      * @ingroup Modules
@@ -57,5 +62,8 @@ namespace allpix {
 
         // Induction matrix size in number of pixels along x and y
         ROOT::Math::DisplacementVector2D<ROOT::Math::Cartesian2D<int>> matrix_;
+
+        // Pixel maps of all worker threads, cleared for every event to reuse their storage
+        std::vector<PixelMap<std::vector<std::pair<double, const PropagatedCharge*>>>> pixel_maps_;
     };
 } // namespace allpix
@@ -87,18 +87,25 @@ void PulseTransferModule::initialize() {
         p_integrated_pulses_ = CreateHistogram<TProfile>(
             "pulses_integrated_profile", "Accumulated induced charge per pixel;t [ns];Q_{ind} [e]", nbins, 0, 10.);
     }
+
+    // Prepare one set of pixel maps for every thread that can run events
+    pixel_pulse_maps_.resize(ThreadPool::threadCount());
+    pixel_charge_maps_.resize(ThreadPool::threadCount());
 }
 
 void PulseTransferModule::run(Event* event) {
     auto propagated_message = messenger_->fetchMessage<PropagatedChargeMessage>(this, event);
 
     // Create map for all pixels: pulse and propagated charges
-    std::map<Pixel::Index, Pulse> pixel_pulse_map;
-    std::map<Pixel::Index, std::vector<const PropagatedCharge*>> pixel_charge_map;
+    auto thread_num = std::min<size_t>(ThreadPool::threadNum(), pixel_pulse_maps_.size() - 1);
+    auto& pixel_pulse_map = pixel_pulse_maps_[thread_num];
+    auto& pixel_charge_map = pixel_charge_maps_[thread_num];
+    pixel_pulse_map.clear();
+    pixel_charge_map.clear();
 
     LOG(DEBUG) << "Received " << propagated_message->getData().size() << " propagated charge objects.";
     for(const auto& propagated_charge : propagated_message->getData()) {
-        auto pulses = propagated_charge.getPulses();
+        const auto& pulses = propagated_charge.getPulses();
 
         if(pulses.empty()) {
             LOG(TRACE) << "No pulse information available - producing pseudo-pulse from arrival time of charge carriers.";
@@ -148,10 +155,10 @@ void PulseTransferModule::run(Event* event) {
             pulse.addCharge(propagated_charge.getCharge(), propagated_charge.getLocalTime());
             pixel_pulse_map[pixel_index] += pulse;
 
-            auto px = pixel_charge_map[pixel_index];
+            auto& px = pixel_charge_map[pixel_index];
             // For each pulse, store the corresponding propagated charges to preserve history:
             if(std::find(px.begin(), px.end(), &propagated_charge) == px.end()) {
-                pixel_charge_map[pixel_index].emplace_back(&propagated_charge);
+                px.emplace_back(&propagated_charge);
             }
         } else {
             LOG(TRACE) << "Found pulse information";
@@ -162,16 +169,17 @@ void PulseTransferModule::run(Event* event) {
                 // Accumulate all pulses from input message data:
                 pixel_pulse_map[pixel_index] += pulse;
 
-                auto px = pixel_charge_map[pixel_index];
+                auto& px = pixel_charge_map[pixel_index];
                 // For each pulse, store the corresponding propagated charges to preserve history:
                 if(std::find(px.begin(), px.end(), &propagated_charge) == px.end()) {
-                    pixel_charge_map[pixel_index].emplace_back(&propagated_charge);
+                    px.emplace_back(&propagated_charge);
                 }
             }
         }
     }
 
-    // Create vector of pixel pulses to return for this detector
+    // Create vector of pixel pulses to return for this detector, ordered by pixel index
+    pixel_pulse_map.sort();
     std::vector<PixelCharge> pixel_charges;
     Pulse total_pulse;
     for(auto& [index, pulse] : pixel_pulse_map) {
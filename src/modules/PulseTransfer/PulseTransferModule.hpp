@@ -8,15 +8,18 @@
  */
 
 #include <string>
+#include <vector>
 
 #include "core/config/Configuration.hpp"
 #include "core/geometry/DetectorModel.hpp"
 #include "core/messenger/Messenger.hpp"
 #include "core/module/Module.hpp"
+#include "core/module/ThreadPool.hpp"
 
 #include "objects/PropagatedCharge.hpp"
 
 #include "tools/ROOT.h"
+#include "tools/pixel_map.h"
 
 #include <TH1D.h>
 #include <TH2D.h>
@@ -73,5 +76,10 @@ namespace allpix {
         Histogram<TH1D> h_total_induced_charge_, h_induced_pixel_charge_;
         Histogram<TH2D> h_induced_pulses_, h_integrated_pulses_;
         Histogram<TProfile> p_induced_pulses_, p_integrated_pulses_;
+
+        // Maps of pulses and propagated charges per pixel of all worker threads, cleared for every event to reuse their
+        // storage
+        std::vector<PixelMap<Pulse>> pixel_pulse_maps_;
+        std::vector<PixelMap<std::vector<const PropagatedCharge*>>> pixel_charge_maps_;
     };
 } // namespace allpix
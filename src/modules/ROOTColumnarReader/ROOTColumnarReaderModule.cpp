@@ -0,0 +1,138 @@
+/**
+ * @file
+ * @brief Implementation of columnar ROOT data file reader module
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "ROOTColumnarReaderModule.hpp"
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "core/config/exceptions.h"
+#include "core/module/exceptions.h"
+#include "core/utils/log.h"
+
+#include "objects/PixelCharge.hpp"
+#include "objects/PixelHit.hpp"
+
+#include "tools/ROOT.h"
+
+using namespace allpix;
+
+ROOTColumnarReaderModule::ROOTColumnarReaderModule(Configuration& config, Messenger* messenger, GeometryManager* geo_mgr)
+    : Module(config), messenger_(messenger), geo_mgr_(geo_mgr) {
+    // Enable multithreading of this module if multithreading is enabled
+    allow_multithreading();
+}
+
+void ROOTColumnarReaderModule::initialize() {
+    // Open the file with the columns
+    auto input_file_name = config_.getPathWithExtension("file_name", "root", true);
+    input_file_ = std::make_unique<TFile>(input_file_name.c_str());
+
+    // Find the detectors referred to by the detector index:
+    std::vector<std::string>* detector_names = nullptr;
+    input_file_->GetObject("detectors", detector_names);
+    if(detector_names == nullptr) {
+        throw InvalidValueError(config_, "file_name", "file does not contain columnar data");
+    }
+    for(const auto& name : *detector_names) {
+        if(!geo_mgr_->hasDetector(name)) {
+            throw InvalidValueError(config_, "file_name", "file contains data for unknown detector '" + name + "'");
+        }
+        detectors_.push_back(geo_mgr_->getDetector(name));
+    }
+
+    // Connect the columns of the stored object types
+    input_file_->GetObject("PixelHit", pixel_hit_tree_);
+    if(pixel_hit_tree_ != nullptr) {
+        pixel_hit_columns_.read(pixel_hit_tree_, "signal", true);
+        LOG(DEBUG) << "Reading PixelHit columns";
+    }
+    input_file_->GetObject("PixelCharge", pixel_charge_tree_);
+    if(pixel_charge_tree_ != nullptr) {
+        // The time of pixel charges is derived from their history and cannot be restored, skip the time columns
+        pixel_charge_columns_.read(pixel_charge_tree_, "charge", false);
+        LOG(DEBUG) << "Reading PixelCharge columns";
+    }
+    if(pixel_hit_tree_ == nullptr && pixel_charge_tree_ == nullptr) {
+        LOG(ERROR) << "Provided ROOT file does not contain any columns, module will not read any data";
+    }
+}
+
+template <typename T> void ROOTColumnarReaderModule::dispatch_columns(const PixelColumns& columns, Event* event) {
+    if(columns.offsets.size() != detectors_.size() + 1) {
+        throw ModuleError("Columns are malformed, offsets do not match the number of detectors");
+    }
+    if(!std::is_sorted(columns.offsets.begin(), columns.offsets.end())) {
+        throw ModuleError("Columns are malformed, offsets are not monotonically increasing");
+    }
+
+    // All rows referred to by the offsets have to be present in every column that is used
+    std::vector<size_t> column_sizes{columns.x.size(), columns.y.size(), columns.value.size()};
+    if constexpr(std::is_same_v<T, PixelHit>) {
+        column_sizes.push_back(columns.local_time.size());
+        column_sizes.push_back(columns.global_time.size());
+    }
+    if(columns.offsets.back() > *std::min_element(column_sizes.begin(), column_sizes.end())) {
+        throw ModuleError("Columns are malformed, offsets exceed the number of rows stored in the columns");
+    }
+
+    for(size_t index = 0; index < detectors_.size(); ++index) {
+        const auto& detector = detectors_[index];
+
+        std::vector<T> objects;
+        objects.reserve(columns.offsets[index + 1] - columns.offsets[index]);
+        for(auto row = columns.offsets[index]; row < columns.offsets[index + 1]; ++row) {
+            auto pixel = detector->getPixel(columns.x[row], columns.y[row]);
+            if constexpr(std::is_same_v<T, PixelHit>) {
+                objects.emplace_back(
+                    std::move(pixel), columns.local_time[row], columns.global_time[row], columns.value[row]);
+            } else {
+                objects.emplace_back(std::move(pixel), static_cast<long>(columns.value[row]));
+            }
+        }
+
+        if(objects.empty()) {
+            continue;
+        }
+        read_cnt_ += objects.size();
+        messenger_->dispatchMessage(this, std::make_shared<Message<T>>(std::move(objects), detector), event);
+    }
+}
+
+void ROOTColumnarReaderModule::run(Event* event) {
+    auto root_lock = root_process_lock();
+
+    // Beware: ROOT uses signed entry counters for its trees
+    auto event_num = static_cast<int64_t>(event->number) - 1;
+    for(auto* tree : {pixel_hit_tree_, pixel_charge_tree_}) {
+        if(tree != nullptr && event_num >= tree->GetEntries()) {
+            throw EndOfRunException("Requesting end of run because TTree only contains data for " +
+                                    std::to_string(event_num) + " events");
+        }
+    }
+
+    LOG(TRACE) << "Building messages from stored columns";
+    if(pixel_hit_tree_ != nullptr) {
+        pixel_hit_tree_->GetEntry(event_num);
+        dispatch_columns<PixelHit>(pixel_hit_columns_, event);
+    }
+    if(pixel_charge_tree_ != nullptr) {
+        pixel_charge_tree_->GetEntry(event_num);
+        dispatch_columns<PixelCharge>(pixel_charge_columns_, event);
+    }
+    ++event_cnt_;
+}
+
+void ROOTColumnarReaderModule::finalize() {
+    LOG(INFO) << "Read columns of " << (pixel_hit_tree_ != nullptr ? 1 : 0) + (pixel_charge_tree_ != nullptr ? 1 : 0)
+              << " object types for " << event_cnt_ << " events";
+    LOG(INFO) << "Read " << read_cnt_ << " objects in total";
+}
@@ -0,0 +1,84 @@
+/**
+ * @file
+ * @brief Definition of columnar ROOT data file reader module
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include "core/config/Configuration.hpp"
+#include "core/geometry/GeometryManager.hpp"
+#include "core/messenger/Messenger.hpp"
+#include "core/module/Event.hpp"
+#include "core/module/Module.hpp"
+
+#include "tools/pixel_columns.h"
+
+namespace allpix {
+    /**
+     * @ingroup Modules
+     * @brief Module to read pixel hits and pixel charges stored as flat columns back to allpix messages
+     *
+     * Reads the columns written by the \ref ROOTColumnarWriterModule and dispatches one message per detector and object type
+     * for every event.
+     */
+    class ROOTColumnarReaderModule : public Module {
+    public:
+        /**
+         * @brief Constructor for this unique module
+         * @param config Configuration object for this module as retrieved from the steering file
+         * @param messenger Pointer to the messenger object to allow binding to messages on the bus
+         * @param geo_mgr Pointer to the geometry manager, containing the detectors
+         */
+        ROOTColumnarReaderModule(Configuration& config, Messenger* messenger, GeometryManager* geo_mgr);
+
+        /**
+         * @brief Open the file and connect the columns of all stored object types
+         */
+        void initialize() override;
+
+        /**
+         * @brief Construct the objects of the current event and dispatch them
+         */
+        void run(Event* event) override;
+
+        /**
+         * @brief Output summary
+         */
+        void finalize() override;
+
+    private:
+        /**
+         * @brief Construct objects from the columns read for the current event and dispatch one message per detector
+         * @param columns Columns of the current event
+         * @param event   Current event to dispatch the messages to
+         */
+        template <typename T> void dispatch_columns(const PixelColumns& columns, Event* event);
+
+        Messenger* messenger_;
+        GeometryManager* geo_mgr_;
+
+        // Detectors in the order of the detector column
+        std::vector<std::shared_ptr<Detector>> detectors_;
+
+        // Input data file and the trees and columns of the stored objects
+        std::unique_ptr<TFile> input_file_;
+        TTree* pixel_hit_tree_{};
+        TTree* pixel_charge_tree_{};
+        PixelColumns pixel_hit_columns_;
+        PixelColumns pixel_charge_columns_;
+
+        // Statistical information
+        std::atomic<unsigned long> read_cnt_{};
+        std::atomic<unsigned long> event_cnt_{};
+    };
+} // namespace allpix
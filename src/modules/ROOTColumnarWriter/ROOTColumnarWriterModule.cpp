@@ -0,0 +1,148 @@
+/**
+ * @file
+ * @brief Implementation of columnar ROOT data file writer module
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "ROOTColumnarWriterModule.hpp"
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "core/config/exceptions.h"
+#include "core/messenger/exceptions.h"
+#include "core/utils/log.h"
+
+#include "tools/ROOT.h"
+
+using namespace allpix;
+
+ROOTColumnarWriterModule::ROOTColumnarWriterModule(Configuration& config, Messenger* messenger, GeometryManager* geo_mgr)
+    : SequentialModule(config), messenger_(messenger), geo_mgr_(geo_mgr) {
+    // Enable multithreading of this module if multithreading is enabled
+    allow_multithreading();
+
+    config_.setDefault<std::string>("file_name", "columns");
+    config_.setDefaultArray<std::string>("include", {"PixelHit", "PixelCharge"});
+
+    for(const auto& name : config_.getArray<std::string>("include")) {
+        if(name == "PixelHit") {
+            write_pixel_hits_ = true;
+        } else if(name == "PixelCharge") {
+            write_pixel_charges_ = true;
+        } else {
+            throw InvalidValueError(config_, "include", "only PixelHit and PixelCharge objects can be stored as columns");
+        }
+    }
+
+    // Bind to the selected objects of all detectors
+    if(write_pixel_hits_) {
+        messenger_->bindMulti<PixelHitMessage>(this, MsgFlags::NONE);
+    }
+    if(write_pixel_charges_) {
+        messenger_->bindMulti<PixelChargeMessage>(this, MsgFlags::NONE);
+    }
+}
+
+void ROOTColumnarWriterModule::initialize() {
+    // Assign detector indices in the order of the geometry
+    for(const auto& detector : geo_mgr_->getDetectors()) {
+        detector_index_[detector->getName()] = detector_names_.size();
+        detector_names_.push_back(detector->getName());
+    }
+
+    // Create output file
+    output_file_name_ = createOutputFile(config_.get<std::string>("file_name"), "root", true);
+    output_file_ = std::make_unique<TFile>(output_file_name_.c_str(), "RECREATE");
+    output_file_->cd();
+
+    if(write_pixel_hits_) {
+        pixel_hit_tree_ = std::make_unique<TTree>("PixelHit", "Columns of PixelHit");
+        pixel_hit_columns_.branch(pixel_hit_tree_.get(), "signal");
+    }
+    if(write_pixel_charges_) {
+        pixel_charge_tree_ = std::make_unique<TTree>("PixelCharge", "Columns of PixelCharge");
+        pixel_charge_columns_.branch(pixel_charge_tree_.get(), "charge");
+    }
+}
+
+template <typename T> void ROOTColumnarWriterModule::fill_columns(PixelColumns& columns, Event* event) {
+    columns.clear();
+
+    // Not every event contains messages of all selected objects
+    std::vector<std::shared_ptr<Message<T>>> messages;
+    try {
+        messages = messenger_->fetchMultiMessage<Message<T>>(this, event);
+    } catch(const MessageNotFoundException&) {
+    }
+
+    // Sort the messages by detector index to group the rows:
+    std::vector<std::vector<std::shared_ptr<Message<T>>>> detector_messages(detector_names_.size());
+    for(const auto& message : messages) {
+        detector_messages[detector_index_.at(message->getDetector()->getName())].push_back(message);
+    }
+
+    for(size_t index = 0; index < detector_messages.size(); ++index) {
+        columns.offsets.push_back(static_cast<UInt_t>(columns.x.size()));
+        for(const auto& message : detector_messages[index]) {
+            for(const auto& object : message->getData()) {
+                const auto& pixel = object.getPixel();
+                columns.detector.push_back(static_cast<UShort_t>(index));
+                columns.x.push_back(pixel.getIndex().x());
+                columns.y.push_back(pixel.getIndex().y());
+                if constexpr(std::is_same_v<T, PixelHit>) {
+                    columns.value.push_back(object.getSignal());
+                } else {
+                    columns.value.push_back(static_cast<double>(object.getCharge()));
+                }
+                columns.local_time.push_back(object.getLocalTime());
+                columns.global_time.push_back(object.getGlobalTime());
+                auto local_center = pixel.getLocalCenter();
+                columns.local_x.push_back(local_center.x());
+                columns.local_y.push_back(local_center.y());
+                columns.local_z.push_back(local_center.z());
+                auto global_center = pixel.getGlobalCenter();
+                columns.global_x.push_back(global_center.x());
+                columns.global_y.push_back(global_center.y());
+                columns.global_z.push_back(global_center.z());
+            }
+        }
+    }
+    columns.offsets.push_back(static_cast<UInt_t>(columns.x.size()));
+    write_cnt_ += columns.x.size();
+}
+
+void ROOTColumnarWriterModule::run(Event* event) {
+    auto root_lock = root_process_lock();
+
+    if(write_pixel_hits_) {
+        fill_columns<PixelHit>(pixel_hit_columns_, event);
+        LOG(TRACE) << "Filling " << pixel_hit_columns_.x.size() << " rows of PixelHit columns";
+        pixel_hit_tree_->Fill();
+    }
+    if(write_pixel_charges_) {
+        fill_columns<PixelCharge>(pixel_charge_columns_, event);
+        LOG(TRACE) << "Filling " << pixel_charge_columns_.x.size() << " rows of PixelCharge columns";
+        pixel_charge_tree_->Fill();
+    }
+    ++event_cnt_;
+}
+
+void ROOTColumnarWriterModule::finalize() {
+    output_file_->cd();
+
+    // Store the detector names to interpret the detector column
+    output_file_->WriteObject(&detector_names_, "detectors");
+
+    output_file_->Write();
+
+    // Print statistics
+    LOG(STATUS) << "Wrote columns of " << (write_pixel_hits_ ? 1 : 0) + (write_pixel_charges_ ? 1 : 0)
+                << " object types for " << event_cnt_ << " events to file:" << std::endl
+                << output_file_name_;
+    LOG(INFO) << "Wrote " << write_cnt_ << " rows in total";
+}
@@ -0,0 +1,93 @@
+/**
+ * @file
+ * @brief Definition of columnar ROOT data file writer module
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include "core/config/Configuration.hpp"
+#include "core/geometry/GeometryManager.hpp"
+#include "core/messenger/Messenger.hpp"
+#include "core/module/Event.hpp"
+#include "core/module/Module.hpp"
+
+#include "objects/PixelCharge.hpp"
+#include "objects/PixelHit.hpp"
+
+#include "tools/pixel_columns.h"
+
+namespace allpix {
+    /**
+     * @ingroup Modules
+     * @brief Module to write pixel hits and pixel charges as flat columns to ROOT trees
+     *
+     * Stores the primitive members of PixelHit and PixelCharge objects of all detectors as one vector per member and event,
+     * which allows reading individual columns without deserializing the full objects. The history of the objects is not
+     * stored.
+     */
+    class ROOTColumnarWriterModule : public SequentialModule {
+    public:
+        /**
+         * @brief Constructor for this unique module
+         * @param config Configuration object for this module as retrieved from the steering file
+         * @param messenger Pointer to the messenger object to allow binding to messages on the bus
+         * @param geo_mgr Pointer to the geometry manager, containing the detectors
+         */
+        ROOTColumnarWriterModule(Configuration& config, Messenger* messenger, GeometryManager* geo_mgr);
+
+        /**
+         * @brief Open the file and create the trees for the selected objects
+         */
+        void initialize() override;
+
+        /**
+         * @brief Fill the columns of all selected objects for the current event
+         */
+        void run(Event* event) override;
+
+        /**
+         * @brief Write the list of detectors and the trees to file
+         */
+        void finalize() override;
+
+    private:
+        /**
+         * @brief Fill the columns from the messages of all detectors, grouped by detector
+         * @param columns Columns to fill
+         * @param event   Current event to fetch the messages from
+         */
+        template <typename T> void fill_columns(PixelColumns& columns, Event* event);
+
+        Messenger* messenger_;
+        GeometryManager* geo_mgr_;
+
+        // Detector names and their index in the detector column
+        std::vector<std::string> detector_names_;
+        std::map<std::string, size_t> detector_index_;
+
+        // Output data file and the trees and columns of the selected objects
+        std::unique_ptr<TFile> output_file_;
+        std::string output_file_name_{};
+        bool write_pixel_hits_{};
+        bool write_pixel_charges_{};
+        std::unique_ptr<TTree> pixel_hit_tree_;
+        std::unique_ptr<TTree> pixel_charge_tree_;
+        PixelColumns pixel_hit_columns_;
+        PixelColumns pixel_charge_columns_;
+
+        // Statistical information
+        std::atomic<unsigned long> write_cnt_{};
+        std::atomic<unsigned long> event_cnt_{};
+    };
+} // namespace allpix
@@ -197,6 +197,18 @@ void ROOTObjectReaderModule::initialize() {
                      << " - this might lead to unexpected behavior.";
     }
 
+    // Read the collections referred to by event-local history references, if stored:
+    std::map<std::string, int> local_collection_ids;
+    std::vector<std::string>* local_collections = nullptr;
+    input_file_->GetObject("local_collections", local_collections);
+    if(local_collections != nullptr) {
+        for(size_t i = 0; i < local_collections->size(); ++i) {
+            local_collection_ids[(*local_collections)[i]] = static_cast<int>(i);
+        }
+        local_collections_ = local_collections->size();
+        LOG(DEBUG) << "Input file uses event-local history references for " << local_collections_ << " collections";
+    }
+
     // Loop over all found trees
     for(auto& tree : trees_) {
         // Loop over the list of branches and create the set of receiver objects
@@ -252,6 +264,11 @@ void ROOTObjectReaderModule::initialize() {
                     message_info_array_.back().detector = geo_mgr_->getDetector(split[det_idx]);
                 }
             }
+
+            auto local_collection = local_collection_ids.find(std::string(tree->GetName()) + "/" + branch_name);
+            if(local_collection != local_collection_ids.end()) {
+                message_info_array_.back().local_collection = local_collection->second;
+            }
         }
     }
 }
@@ -296,6 +313,18 @@ void ROOTObjectReaderModule::run(Event* event) {
         message_inf.message = iter->second(*objects, message_inf.detector);
     }
 
+    // Provide the objects of this event to resolve event-local history references
+    Object::LocalObjectTable local_objects(local_collections_);
+    for(auto& message_inf : message_info_array_) {
+        if(!message_inf.message || message_inf.local_collection < 0) {
+            continue;
+        }
+        auto& collection = local_objects[static_cast<size_t>(message_inf.local_collection)];
+        for(auto& object : message_inf.message->getObjectArray()) {
+            collection.push_back(&object.get());
+        }
+    }
+
     for(auto& message_inf : message_info_array_) {
         // We might not have every message, so just continue
         if(!message_inf.message) {
@@ -304,7 +333,7 @@ void ROOTObjectReaderModule::run(Event* event) {
 
         // Resolve history
         for(auto& object : message_inf.message->getObjectArray()) {
-            object.get().loadHistory();
+            object.get().loadHistory(&local_objects);
         }
 
         // Dispatch the messages
@@ -76,6 +76,7 @@ namespace allpix {
             std::shared_ptr<Detector> detector;
             std::string name;
             std::shared_ptr<BaseMessage> message;
+            int local_collection{-1};
         };
 
         // Object names to include or exclude from reading
@@ -91,6 +92,9 @@ namespace allpix {
         // List of objects and message information converted from the trees
         std::list<message_info> message_info_array_;
 
+        // Number of collections referred to by event-local history references
+        size_t local_collections_{};
+
         // Statistics for total amount of objects stored
         std::atomic<unsigned long> read_cnt_{};
 
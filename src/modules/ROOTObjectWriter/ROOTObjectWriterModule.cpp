@@ -11,6 +11,7 @@
 
 #include <fstream>
 #include <string>
+#include <typeindex>
 #include <utility>
 
 #include <TBranchElement.h>
@@ -20,6 +21,7 @@
 #include "core/config/ConfigReader.hpp"
 #include "core/utils/log.h"
 #include "core/utils/type.h"
+#include "core/utils/unit.h"
 
 #include "objects/Object.hpp"
 #include "objects/objects.h"
@@ -35,6 +37,34 @@ ROOTObjectWriterModule::ROOTObjectWriterModule(Configuration& config, Messenger*
 
     // Bind to all messages with filter
     messenger_->registerFilter(this, &ROOTObjectWriterModule::filter);
+
+    config_.setDefault<HistoryReferences>("history_references", HistoryReferences::TREF);
+    history_references_ = config_.get<HistoryReferences>("history_references");
+
+    config_.setDefault<Pulse::Storage>("pulse_storage", Pulse::Storage::DENSE);
+    config_.setDefault<double>("pulse_threshold", 0.);
+    config_.setDefault<double>("pulse_quantum", Units::get(1e-3, "e"));
+    pulse_format_.storage = config_.get<Pulse::Storage>("pulse_storage");
+    pulse_format_.threshold = config_.get<double>("pulse_threshold");
+    pulse_format_.quantum = config_.get<double>("pulse_quantum");
+    if(pulse_format_.threshold < 0) {
+        throw InvalidValueError(config_, "pulse_threshold", "threshold cannot be negative");
+    }
+    if(pulse_format_.storage == Pulse::Storage::SPARSE_QUANTIZED && pulse_format_.quantum <= 0) {
+        throw InvalidValueError(config_, "pulse_quantum", "quantum has to be positive");
+    }
+}
+
+/**
+ * The branch name consists of the detector name, or "global" for messages without detector, and the message name if set
+ */
+static std::string get_branch_name(const std::string& detector_name, const std::string& message_name) {
+    std::string branch_name = detector_name.empty() ? "global" : detector_name;
+    if(!message_name.empty()) {
+        branch_name += "_";
+        branch_name += message_name;
+    }
+    return branch_name;
 }
 /**
  * @note Objects cannot be stored in smart pointers due to internal ROOT logic
@@ -63,6 +93,8 @@ void ROOTObjectWriterModule::initialize() {
         auto exc_arr = config_.getArray<std::string>("exclude");
         exclude_.insert(exc_arr.begin(), exc_arr.end());
     }
+
+    LOG(INFO) << "Storing pulses in " << allpix::to_string(pulse_format_.storage) << " format";
 }
 
 bool ROOTObjectWriterModule::filter(const std::shared_ptr<BaseMessage>& message,
@@ -106,19 +138,56 @@ bool ROOTObjectWriterModule::filter(const std::shared_ptr<BaseMessage>& message,
     return true;
 }
 
+void ROOTObjectWriterModule::compress_pulses(Object& object) const {
+    if(pulse_format_.storage == Pulse::Storage::DENSE) {
+        return;
+    }
+
+    if(auto* pixel_charge = dynamic_cast<PixelCharge*>(&object)) {
+        pixel_charge->compressPulse(pulse_format_);
+    } else if(auto* propagated_charge = dynamic_cast<PropagatedCharge*>(&object)) {
+        propagated_charge->compressPulses(pulse_format_);
+    }
+}
+
 void ROOTObjectWriterModule::run(Event* event) {
     auto root_lock = root_process_lock();
 
     auto messages = messenger_->fetchFilteredMessages(this, event);
 
-    // Mark objects to be stored:
+    // Mark objects to be stored and assign event-local references if requested:
+    Object::LocalReferenceMap local_references;
+    std::map<int, int> local_collection_sizes;
     for(auto& pair : messages) {
         auto& message = pair.first;
         auto object_array = message->getObjectArray();
         for(Object& object : object_array) {
             object.markForStorage();
         }
+
+        if(history_references_ == HistoryReferences::LOCAL) {
+            std::string detector_name;
+            if(message->getDetector() != nullptr) {
+                detector_name = message->getDetector()->getName();
+            }
+            const Object& first_object = object_array[0];
+            auto index_tuple = std::make_tuple(std::type_index(typeid(first_object)), detector_name, pair.second);
+
+            // Assign identifiers to collections in order of their first appearance:
+            auto collection = local_collections_.emplace(index_tuple, static_cast<int>(local_collections_.size()));
+            if(collection.second) {
+                local_collection_names_.push_back(allpix::demangle(typeid(first_object).name()) + "/" +
+                                                  get_branch_name(detector_name, pair.second));
+            }
+
+            // Messages with identical collection are appended to the same branch, so indices continue:
+            auto& size = local_collection_sizes[collection.first->second];
+            for(Object& object : object_array) {
+                local_references.emplace(&object, std::make_pair(collection.first->second, size++));
+            }
+        }
     }
+    const auto* history_references = (history_references_ == HistoryReferences::LOCAL ? &local_references : nullptr);
 
     // Generate trees and index data
     for(auto& pair : messages) {
@@ -156,11 +225,7 @@ void ROOTObjectWriterModule::run(Event* event) {
                                std::make_unique<TTree>(class_name.c_str(), (std::string("Tree of ") + class_name).c_str()));
             }
 
-            std::string branch_name = detector_name.empty() ? "global" : detector_name;
-            if(!message_name.empty()) {
-                branch_name += "_";
-                branch_name += message_name;
-            }
+            auto branch_name = get_branch_name(detector_name, message_name);
 
             trees_[class_name]->Bronch(
                 branch_name.c_str(), (std::string("std::vector<") + class_name_with_namespace + "*>").c_str(), addr);
@@ -185,10 +250,11 @@ void ROOTObjectWriterModule::run(Event* event) {
 
         // Fill the branch vector
         for(Object& object : object_array) {
-            // Trigger the creation of TRefs for cross-object references to be able to store them to file.
-            // We can reset the TObject count after processing this event because the TRef creation is only done here locally
-            // in one worker thread instead of framew-work wide.
-            object.petrifyHistory();
+            // Trigger the creation of TRefs or event-local references for cross-object references to be able to store them
+            // to file. We can reset the TObject count after processing this event because the TRef creation is only done here
+            // locally in one worker thread instead of framew-work wide.
+            object.petrifyHistory(history_references);
+            compress_pulses(object);
             ++write_cnt_;
             write_list_[index_tuple]->push_back(&object);
         }
@@ -296,6 +362,13 @@ void ROOTObjectWriterModule::finalize() {
         }
     }
 
+    // Store the collections referred to by event-local history references
+    if(history_references_ == HistoryReferences::LOCAL) {
+        output_file_->cd();
+        output_file_->WriteObject(&local_collection_names_, "local_collections");
+        LOG(DEBUG) << "Wrote " << local_collection_names_.size() << " collections for event-local history references";
+    }
+
     // Finish writing to output file
     output_file_->Write();
 
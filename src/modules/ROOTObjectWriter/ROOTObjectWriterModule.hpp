@@ -10,6 +10,7 @@
 #include <atomic>
 #include <map>
 #include <string>
+#include <vector>
 
 #include <TFile.h>
 #include <TTree.h>
@@ -20,6 +21,8 @@
 #include "core/module/Event.hpp"
 #include "core/module/Module.hpp"
 
+#include "objects/Pulse.hpp"
+
 namespace allpix {
     /**
      * @ingroup Modules
@@ -30,6 +33,14 @@ namespace allpix {
      * branch is created for every combination of detector name and message name that outputs this object.
      */
     class ROOTObjectWriterModule : public SequentialModule {
+        /**
+         * @brief Types of references used to store the history of objects
+         */
+        enum class HistoryReferences {
+            TREF,  ///< Persistent ROOT references, registered in the process ID tables
+            LOCAL, ///< Event-local references given by the stored collection and the index within the collection
+        };
+
     public:
         /**
          * @brief Constructor for this unique module
@@ -67,6 +78,12 @@ namespace allpix {
         void finalize() override;
 
     private:
+        /**
+         * @brief Compress the pulses held by an object with the configured storage format before writing it
+         * @param object Object to compress the pulses of, objects without pulses are left untouched
+         */
+        void compress_pulses(Object& object) const;
+
         Messenger* messenger_;
         GeometryManager* geo_mgr_;
 
@@ -87,6 +104,14 @@ namespace allpix {
         // List of objects of a particular type, bound to a specific detector and having a particular name
         std::map<std::tuple<std::type_index, std::string, std::string>, std::vector<Object*>*> write_list_;
 
+        // Type of history references and event-local identifiers of all collections, i.e. branches, written so far
+        HistoryReferences history_references_{};
+        std::map<std::tuple<std::type_index, std::string, std::string>, int> local_collections_;
+        std::vector<std::string> local_collection_names_;
+
+        // Format in which pulses are stored
+        Pulse::StorageFormat pulse_format_{};
+
         // Statistical information about number of objects
         std::atomic<unsigned long> write_cnt_{};
     };
@@ -0,0 +1,195 @@
+/**
+ * @file
+ * @brief Implementation of module to generate charge-sharing response tables
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "ResponseTableGeneratorModule.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "core/config/exceptions.h"
+#include "core/utils/log.h"
+#include "core/utils/unit.h"
+
+using namespace allpix;
+using namespace ROOT::Math;
+
+ResponseTableGeneratorModule::ResponseTableGeneratorModule(Configuration& config,
+                                                           Messenger* messenger,
+                                                           std::shared_ptr<Detector> detector)
+    : Module(config, detector), messenger_(messenger), detector_(std::move(detector)) {
+    // Enable multithreading of this module if multithreading is enabled
+    allow_multithreading();
+
+    using XYVectorInt = DisplacementVector2D<Cartesian2D<int>>;
+    using XYZVectorInt = DisplacementVector3D<Cartesian3D<int>>;
+
+    // Save detector model
+    model_ = detector_->getModel();
+
+    // Set default value for config variables
+    config_.setDefault<std::string>("file_name", "response_table");
+    config_.setDefault<XYZVectorInt>("bins", XYZVectorInt(10, 10, 10));
+    config_.setDefault<XYVectorInt>("matrix", XYVectorInt(3, 3));
+
+    auto bins = config_.get<XYZVectorInt>("bins");
+    if(bins.x() < 1 || bins.y() < 1 || bins.z() < 1) {
+        throw InvalidValueError(config_, "bins", "At least one bin required in every dimension.");
+    }
+    auto matrix = config_.get<XYVectorInt>("matrix");
+    if(matrix.x() < 1 || matrix.y() < 1 || matrix.x() % 2 == 0 || matrix.y() % 2 == 0) {
+        throw InvalidValueError(config_, "matrix", "Odd number of pixels in x and y required.");
+    }
+
+    table_ = ResponseTable({static_cast<size_t>(bins.x()), static_cast<size_t>(bins.y()), static_cast<size_t>(bins.z())},
+                           {model_->getPixelSize().x(), model_->getPixelSize().y(), model_->getSensorSize().z()},
+                           {static_cast<size_t>(matrix.x()), static_cast<size_t>(matrix.y())});
+
+    // Require deposited charges and the resulting pixel charges for single detector
+    messenger_->bindSingle<DepositedChargeMessage>(this, MsgFlags::REQUIRED);
+    messenger_->bindSingle<PixelChargeMessage>(this, MsgFlags::REQUIRED);
+}
+
+void ResponseTableGeneratorModule::initialize() {
+    for(auto type : {CarrierType::ELECTRON, CarrierType::HOLE}) {
+        auto& accumulator = accumulators_[type];
+        accumulator.deposited.resize(table_.getNumberOfBins());
+        accumulator.collected.resize(table_.getNumberOfBins() * table_.getMatrixSize());
+        accumulator.time_sum.resize(table_.getNumberOfBins() * table_.getMatrixSize());
+        accumulator.time_sum2.resize(table_.getNumberOfBins() * table_.getMatrixSize());
+    }
+
+    auto bins = table_.getBins();
+    LOG(INFO) << "Generating response table with " << bins[0] << "x" << bins[1] << "x" << bins[2] << " bins and "
+              << table_.getMatrix()[0] << "x" << table_.getMatrix()[1] << " pixel matrix";
+}
+
+std::pair<size_t, std::pair<int, int>> ResponseTableGeneratorModule::find_bin(const DepositedCharge& deposit) const {
+    auto position = deposit.getLocalPosition();
+    auto pixel = model_->getPixelIndex(position);
+
+    // Position relative to the pixel center and depth relative to the lower sensor edge:
+    auto x = position.x() - pixel.first * model_->getPixelSize().x();
+    auto y = position.y() - pixel.second * model_->getPixelSize().y();
+    auto z = position.z() - (model_->getSensorCenter().z() - model_->getSensorSize().z() / 2.0);
+    return {table_.getBin(x, y, z), pixel};
+}
+
+void ResponseTableGeneratorModule::run(Event* event) {
+    auto deposits_message = messenger_->fetchMessage<DepositedChargeMessage>(this, event);
+    auto pixel_message = messenger_->fetchMessage<PixelChargeMessage>(this, event);
+
+    // Collect contributions of this event first to keep the lock short
+    std::vector<std::tuple<CarrierType, size_t, double>> deposited;
+    std::vector<std::tuple<CarrierType, size_t, double, double>> collected;
+
+    for(const auto& deposit : deposits_message->getData()) {
+        deposited.emplace_back(deposit.getType(), find_bin(deposit).first, deposit.getCharge());
+    }
+
+    unsigned long outside_matrix = 0;
+    for(const auto& pixel_charge : pixel_message->getData()) {
+        auto index = pixel_charge.getIndex();
+        for(const auto& propagated_charge : pixel_charge.getPropagatedCharges()) {
+            const auto* deposit = propagated_charge->getDepositedCharge();
+            if(deposit == nullptr) {
+                continue;
+            }
+
+            auto [bin, pixel] = find_bin(*deposit);
+            auto dx = static_cast<int>(index.x()) - pixel.first;
+            auto dy = static_cast<int>(index.y()) - pixel.second;
+            if(!table_.isWithinMatrix(dx, dy)) {
+                outside_matrix += propagated_charge->getCharge();
+                continue;
+            }
+
+            collected.emplace_back(propagated_charge->getType(),
+                                   bin * table_.getMatrixSize() + table_.getMatrixIndex(dx, dy),
+                                   propagated_charge->getCharge(),
+                                   propagated_charge->getLocalTime() - deposit->getLocalTime());
+        }
+    }
+    total_outside_matrix_ += outside_matrix;
+
+    LOG(DEBUG) << "Accumulating " << deposited.size() << " deposits and " << collected.size()
+               << " sets of collected charge carriers";
+
+    std::lock_guard<std::mutex> lock{accumulator_mutex_};
+    for(const auto& [type, bin, charge] : deposited) {
+        accumulators_[type].deposited[bin] += charge;
+    }
+    for(const auto& [type, index, charge, time] : collected) {
+        auto& accumulator = accumulators_[type];
+        accumulator.collected[index] += charge;
+        accumulator.time_sum[index] += charge * time;
+        accumulator.time_sum2[index] += charge * time * time;
+    }
+}
+
+void ResponseTableGeneratorModule::finalize() {
+    if(total_outside_matrix_ > 0) {
+        LOG(WARNING) << total_outside_matrix_
+                     << " charge carriers were collected outside the response matrix, consider increasing its size";
+    }
+
+    for(const auto& [type, accumulator] : accumulators_) {
+        // Only store carrier types which have been collected at all:
+        double total_deposited = 0, total_collected = 0;
+        for(const auto& charge : accumulator.deposited) {
+            total_deposited += charge;
+        }
+        for(const auto& charge : accumulator.collected) {
+            total_collected += charge;
+        }
+        if(total_collected == 0) {
+            LOG(INFO) << "No " << type << " charge carriers collected, not adding them to the response table";
+            continue;
+        }
+
+        size_t empty_bins = 0;
+        auto& responses = table_.getResponses(type);
+        for(size_t bin = 0; bin < table_.getNumberOfBins(); ++bin) {
+            auto deposited = accumulator.deposited[bin];
+            if(deposited == 0) {
+                empty_bins++;
+                continue;
+            }
+            for(size_t pixel = 0; pixel < table_.getMatrixSize(); ++pixel) {
+                auto index = bin * table_.getMatrixSize() + pixel;
+                auto collected = accumulator.collected[index];
+                if(collected == 0) {
+                    continue;
+                }
+                auto mean = accumulator.time_sum[index] / collected;
+                responses[index].fraction = collected / deposited;
+                responses[index].time_mean = mean;
+                responses[index].time_rms = std::sqrt(std::max(accumulator.time_sum2[index] / collected - mean * mean, 0.));
+            }
+        }
+
+        if(empty_bins > 0) {
+            LOG(WARNING) << empty_bins << " of " << table_.getNumberOfBins() << " bins did not receive any " << type
+                         << " deposits, consider increasing the number of events";
+        }
+        LOG(INFO) << "Added response of " << type << " charge carriers to the table, collected "
+                  << total_collected / total_deposited * 100 << "% of the deposited charge carriers";
+    }
+
+    auto file_name = createOutputFile(config_.get<std::string>("file_name"), "bin");
+    try {
+        table_.write(file_name);
+    } catch(std::runtime_error& e) {
+        throw ModuleError("Could not write response table: " + std::string(e.what()));
+    }
+    LOG(STATUS) << "Wrote response table to file:" << std::endl << file_name;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file
+ * @brief Definition of module to generate charge-sharing response tables
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/config/Configuration.hpp"
+#include "core/geometry/DetectorModel.hpp"
+#include "core/messenger/Messenger.hpp"
+#include "core/module/Event.hpp"
+#include "core/module/Module.hpp"
+
+#include "objects/DepositedCharge.hpp"
+#include "objects/PixelCharge.hpp"
+
+#include "tools/response_table.h"
+
+namespace allpix {
+    /**
+     * @ingroup Modules
+     * @brief Module to build binned charge-sharing response tables from fully simulated events
+     * @note This module supports multithreading
+     *
+     * The module relates the pixel charges produced by a full charge transport simulation to the position of the deposited
+     * charge carriers they originate from. The in-pixel position and depth of the deposition are binned and the fraction of
+     * collected charge carriers as well as their arrival times are accumulated for all pixels of a matrix around the pixel
+     * of the deposition. The resulting table is written to file at the end of the run and can be used by the
+     * ResponseTablePropagation module.
+     */
+    class ResponseTableGeneratorModule : public Module {
+    public:
+        /**
+         * @brief Constructor for this detector-specific module
+         * @param config Configuration object for this module as retrieved from the steering file
+         * @param messenger Pointer to the messenger object to allow binding to messages on the bus
+         * @param detector Pointer to the detector for this module instance
+         */
+        ResponseTableGeneratorModule(Configuration& config, Messenger* messenger, std::shared_ptr<Detector> detector);
+
+        /**
+         * @brief Initialize the accumulators of the response table
+         */
+        void initialize() override;
+
+        /**
+         * @brief Accumulate the response of the pixels to the deposited charge carriers
+         */
+        void run(Event*) override;
+
+        /**
+         * @brief Calculate the response table and write it to file
+         */
+        void finalize() override;
+
+    private:
+        /**
+         * @brief Accumulated charge and arrival times for one charge carrier type
+         */
+        struct Accumulator {
+            std::vector<double> deposited;
+            std::vector<double> collected;
+            std::vector<double> time_sum;
+            std::vector<double> time_sum2;
+        };
+
+        /**
+         * @brief Find the table bin for the position of a deposited charge
+         * @param deposit Deposited charge
+         * @return Pair of the bin index and the pixel index of the deposition
+         */
+        std::pair<size_t, std::pair<int, int>> find_bin(const DepositedCharge& deposit) const;
+
+        Messenger* messenger_;
+        std::shared_ptr<Detector> detector_;
+        std::shared_ptr<DetectorModel> model_;
+
+        // Response table defining the binning, filled at the end of the run
+        ResponseTable table_;
+
+        // Accumulated response, shared between all events
+        std::map<CarrierType, Accumulator> accumulators_;
+        std::mutex accumulator_mutex_;
+
+        // Statistical information
+        std::atomic<unsigned long> total_outside_matrix_{};
+    };
+} // namespace allpix
@@ -0,0 +1,165 @@
+/**
+ * @file
+ * @brief Implementation of module to propagate charge carriers by sampling from charge-sharing response tables
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "ResponseTablePropagationModule.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/config/exceptions.h"
+#include "core/utils/distributions.h"
+#include "core/utils/log.h"
+#include "core/utils/unit.h"
+
+using namespace allpix;
+
+ResponseTablePropagationModule::ResponseTablePropagationModule(Configuration& config,
+                                                               Messenger* messenger,
+                                                               std::shared_ptr<Detector> detector)
+    : Module(config, detector), messenger_(messenger), detector_(std::move(detector)) {
+    // Enable multithreading of this module if multithreading is enabled
+    allow_multithreading();
+
+    // Save detector model
+    model_ = detector_->getModel();
+
+    // Set default value for config variables
+    config_.setDefault<unsigned int>("charge_per_step", 10);
+    charge_per_step_ = config_.get<unsigned int>("charge_per_step");
+    if(charge_per_step_ == 0) {
+        throw InvalidValueError(config_, "charge_per_step", "At least one charge carrier per step required.");
+    }
+
+    // Require deposits message for single detector
+    messenger_->bindSingle<DepositedChargeMessage>(this, MsgFlags::REQUIRED);
+}
+
+void ResponseTablePropagationModule::initialize() {
+    auto file_name = config_.getPath("file_name", true);
+    try {
+        table_ = ResponseTable::read(file_name);
+    } catch(std::runtime_error& e) {
+        throw InvalidValueError(config_, "file_name", "Could not read response table: " + std::string(e.what()));
+    }
+
+    // The table has been generated for a specific pixel cell and sensor thickness:
+    auto size = table_.getSize();
+    auto tolerance = Units::get(0.01, "um");
+    if(std::fabs(size[0] - model_->getPixelSize().x()) > tolerance ||
+       std::fabs(size[1] - model_->getPixelSize().y()) > tolerance ||
+       std::fabs(size[2] - model_->getSensorSize().z()) > tolerance) {
+        throw InvalidValueError(config_,
+                                "file_name",
+                                "Response table generated for pixel pitch of " +
+                                    Units::display(ROOT::Math::XYVector(size[0], size[1]), {"um"}) +
+                                    " and thickness of " + Units::display(size[2], {"um"}) +
+                                    ", which does not match the detector model");
+    }
+
+    auto bins = table_.getBins();
+    LOG(INFO) << "Loaded response table with " << bins[0] << "x" << bins[1] << "x" << bins[2] << " bins and "
+              << table_.getMatrix()[0] << "x" << table_.getMatrix()[1] << " pixel matrix";
+    for(auto type : {CarrierType::ELECTRON, CarrierType::HOLE}) {
+        if(!table_.hasResponses(type)) {
+            LOG(INFO) << "Response table does not contain " << type << " charge carriers, they will be ignored";
+        }
+    }
+}
+
+void ResponseTablePropagationModule::run(Event* event) {
+    auto deposits_message = messenger_->fetchMessage<DepositedChargeMessage>(this, event);
+
+    // Charge carriers arrive at the pixel centers on the collection side of the sensor:
+    auto collection_z = model_->getSensorCenter().z() + model_->getSensorSize().z() / 2.0;
+
+    std::vector<PropagatedCharge> propagated_charges;
+    unsigned long propagated_charges_count = 0;
+    for(const auto& deposit : deposits_message->getData()) {
+        auto type = deposit.getType();
+        if(!table_.hasResponses(type)) {
+            continue;
+        }
+
+        auto position = deposit.getLocalPosition();
+        auto [xpixel, ypixel] = model_->getPixelIndex(position);
+        auto bin = table_.getBin(position.x() - xpixel * model_->getPixelSize().x(),
+                                 position.y() - ypixel * model_->getPixelSize().y(),
+                                 position.z() - (model_->getSensorCenter().z() - model_->getSensorSize().z() / 2.0));
+        const auto& responses = table_.getResponses(type);
+
+        LOG(DEBUG) << "Set of " << deposit.getCharge() << " charge carriers (" << type << ") on "
+                   << Units::display(position, {"mm", "um"}) << " sampled from table bin " << bin;
+
+        // Sample the multinomial distribution by a sequence of binomial distributions:
+        unsigned int charges_remaining = deposit.getCharge();
+        double fraction_remaining = 1.;
+        auto matrix = table_.getMatrix();
+        for(int dx = -static_cast<int>(matrix[0] / 2); dx <= static_cast<int>(matrix[0] / 2); ++dx) {
+            for(int dy = -static_cast<int>(matrix[1] / 2); dy <= static_cast<int>(matrix[1] / 2); ++dy) {
+                const auto& response = responses[bin * table_.getMatrixSize() + table_.getMatrixIndex(dx, dy)];
+                if(charges_remaining == 0 || response.fraction <= 0 || fraction_remaining <= 0) {
+                    continue;
+                }
+
+                allpix::binomial_distribution<unsigned int> binomial(
+                    charges_remaining, std::min(response.fraction / fraction_remaining, 1.));
+                auto charges = binomial(event->getRandomEngine());
+                charges_remaining -= charges;
+                fraction_remaining -= response.fraction;
+
+                // Charge carriers arriving outside the pixel grid are lost
+                if(charges == 0 || !model_->isWithinPixelGrid(xpixel + dx, ypixel + dy)) {
+                    continue;
+                }
+
+                auto center = model_->getPixelCenter(static_cast<unsigned int>(xpixel + dx),
+                                                     static_cast<unsigned int>(ypixel + dy));
+                auto local_position = ROOT::Math::XYZPoint(center.x(), center.y(), collection_z);
+                auto global_position = detector_->getGlobalPosition(local_position);
+
+                // Create sets of charge carriers with individually sampled arrival times
+                allpix::normal_distribution<double> arrival_time(response.time_mean, response.time_rms);
+                while(charges > 0) {
+                    auto charge_per_step = std::min(charges, charge_per_step_);
+                    charges -= charge_per_step;
+
+                    auto drift_time = std::max(arrival_time(event->getRandomEngine()), 0.);
+                    propagated_charges.emplace_back(local_position,
+                                                    global_position,
+                                                    type,
+                                                    charge_per_step,
+                                                    deposit.getLocalTime() + drift_time,
+                                                    deposit.getGlobalTime() + drift_time,
+                                                    &deposit);
+                    propagated_charges_count += charge_per_step;
+
+                    LOG(TRACE) << "Set of " << charge_per_step << " charge carriers arrived at pixel (" << xpixel + dx
+                               << "," << ypixel + dy << ") after " << Units::display(drift_time, {"ps", "ns"});
+                }
+            }
+        }
+    }
+
+    LOG(INFO) << "Propagated " << propagated_charges_count << " charges in " << propagated_charges.size() << " sets";
+    total_deposits_ += deposits_message->getData().size();
+    total_propagated_charges_ += propagated_charges_count;
+
+    // Dispatch message of propagated charges
+    auto propagated_charge_message = std::make_shared<PropagatedChargeMessage>(std::move(propagated_charges), detector_);
+    messenger_->dispatchMessage(this, propagated_charge_message, event);
+}
+
+void ResponseTablePropagationModule::finalize() {
+    LOG(INFO) << "Sampled " << total_propagated_charges_ << " propagated charges from " << total_deposits_
+              << " deposits using the response table";
+}
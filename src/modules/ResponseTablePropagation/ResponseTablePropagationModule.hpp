@@ -0,0 +1,75 @@
+/**
+ * @file
+ * @brief Definition of module to propagate charge carriers by sampling from charge-sharing response tables
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "core/config/Configuration.hpp"
+#include "core/geometry/DetectorModel.hpp"
+#include "core/messenger/Messenger.hpp"
+#include "core/module/Event.hpp"
+#include "core/module/Module.hpp"
+
+#include "objects/DepositedCharge.hpp"
+#include "objects/PropagatedCharge.hpp"
+
+#include "tools/response_table.h"
+
+namespace allpix {
+    /**
+     * @ingroup Modules
+     * @brief Module to replace the charge transport by sampling from a pre-computed response table
+     * @note This module supports multithreading
+     *
+     * The module looks up the response of the pixel matrix for the in-pixel position and depth of every deposited charge.
+     * The number of charge carriers arriving at each pixel is sampled from a multinomial distribution with the tabulated
+     * collection fractions, their arrival times from a Gaussian distribution with the tabulated mean and RMS. The charge
+     * carriers are placed at the center of the respective pixel on the collection side of the sensor.
+     */
+    class ResponseTablePropagationModule : public Module {
+    public:
+        /**
+         * @brief Constructor for this detector-specific module
+         * @param config Configuration object for this module as retrieved from the steering file
+         * @param messenger Pointer to the messenger object to allow binding to messages on the bus
+         * @param detector Pointer to the detector for this module instance
+         */
+        ResponseTablePropagationModule(Configuration& config, Messenger* messenger, std::shared_ptr<Detector> detector);
+
+        /**
+         * @brief Read the response table and check it against the detector model
+         */
+        void initialize() override;
+
+        /**
+         * @brief Sample the propagated charges for all deposits from the response table
+         */
+        void run(Event*) override;
+
+        /**
+         * @brief Display statistical summary
+         */
+        void finalize() override;
+
+    private:
+        Messenger* messenger_;
+        std::shared_ptr<Detector> detector_;
+        std::shared_ptr<DetectorModel> model_;
+
+        ResponseTable table_;
+
+        // Configuration parameters
+        unsigned int charge_per_step_{};
+
+        // Statistical information
+        std::atomic<unsigned long> total_deposits_{};
+        std::atomic<unsigned long> total_propagated_charges_{};
+    };
+} // namespace allpix
@@ -77,6 +77,9 @@ void SimpleTransferModule::initialize() {
                                                  0.,
                                                  config_.get<double>("output_plots_range"));
     }
+
+    // Prepare one pixel map for every thread that can run events
+    pixel_maps_.resize(ThreadPool::threadCount());
 }
 
 void SimpleTransferModule::run(Event* event) {
@@ -85,7 +88,8 @@ void SimpleTransferModule::run(Event* event) {
     // Find corresponding pixels for all propagated charges
     LOG(TRACE) << "Transferring charges to pixels";
     unsigned int transferred_charges_count = 0;
-    std::map<Pixel::Index, std::vector<const PropagatedCharge*>> pixel_map;
+    auto& pixel_map = pixel_maps_[std::min<size_t>(ThreadPool::threadNum(), pixel_maps_.size() - 1)];
+    pixel_map.clear();
     for(const auto& propagated_charge : propagated_message->getData()) {
         auto position = propagated_charge.getLocalPosition();
         // Ignore if outside depth range of implant
@@ -134,8 +138,9 @@ void SimpleTransferModule::run(Event* event) {
         pixel_map[pixel_index].emplace_back(&propagated_charge);
     }
 
-    // Create pixel charges
+    // Create pixel charges, ordered by pixel index
     LOG(TRACE) << "Combining charges at same pixel";
+    pixel_map.sort();
     std::vector<PixelCharge> pixel_charges;
     for(auto& pixel_index_charge : pixel_map) {
         long charge = 0;
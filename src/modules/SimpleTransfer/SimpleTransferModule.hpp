@@ -19,12 +19,14 @@
 #include "core/messenger/Messenger.hpp"
 #include "core/module/Event.hpp"
 #include "core/module/Module.hpp"
+#include "core/module/ThreadPool.hpp"
 
 #include "objects/Pixel.hpp"
 #include "objects/PixelCharge.hpp"
 #include "objects/PropagatedCharge.hpp"
 
 #include "tools/ROOT.h"
+#include "tools/pixel_map.h"
 
 namespace allpix {
     /**
@@ -78,5 +80,8 @@ namespace allpix {
 
         // Statistical information
         std::atomic<unsigned int> total_transferred_charges_{};
+
+        // Pixel maps of all worker threads, cleared for every event to reuse their storage
+        std::vector<PixelMap<std::vector<const PropagatedCharge*>>> pixel_maps_;
     };
 } // namespace allpix
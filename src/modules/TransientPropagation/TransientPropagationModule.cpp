@@ -9,6 +9,8 @@
 
 #include "TransientPropagationModule.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <memory>
 #include <string>
@@ -21,6 +23,7 @@
 #include "objects/PixelCharge.hpp"
 #include "objects/PropagatedCharge.hpp"
 #include "tools/runge_kutta.h"
+#include "tools/timestep_control.h"
 
 using namespace allpix;
 using namespace ROOT::Math;
@@ -42,6 +45,11 @@ TransientPropagationModule::TransientPropagationModule(Configuration& config,
 
     // Set default value for config variables
     config_.setDefault<double>("timestep", Units::get(0.01, "ns"));
+    config_.setDefault<bool>("adaptive_timestep", false);
+    config_.setDefault<double>("timestep_min", Units::get(0.001, "ns"));
+    config_.setDefault<double>("timestep_max", Units::get(0.5, "ns"));
+    config_.setDefault<double>("timestep_safety_factor", 0.9);
+    config_.setDefault<double>("spatial_precision", Units::get(0.25, "nm"));
     config_.setDefault<double>("integration_time", Units::get(25, "ns"));
     config_.setDefault<unsigned int>("charge_per_step", 10);
 
@@ -57,6 +65,15 @@ TransientPropagationModule::TransientPropagationModule(Configuration& config,
     // Copy some variables from configuration to avoid lookups:
     temperature_ = config_.get<double>("temperature");
     timestep_ = config_.get<double>("timestep");
+    adaptive_timestep_ = config_.get<bool>("adaptive_timestep");
+    timestep_min_ = config_.get<double>("timestep_min");
+    timestep_max_ = config_.get<double>("timestep_max");
+    timestep_safety_factor_ = config_.get<double>("timestep_safety_factor");
+    if(timestep_safety_factor_ <= 0 || timestep_safety_factor_ > 1) {
+        throw InvalidValueError(
+            config_, "timestep_safety_factor", "safety factor has to be larger than zero and at most one");
+    }
+    target_spatial_precision_ = config_.get<double>("spatial_precision");
     integration_time_ = config_.get<double>("integration_time");
     matrix_ = config_.get<XYVectorInt>("induction_matrix");
     charge_per_step_ = config_.get<unsigned int>("charge_per_step");
@@ -65,6 +82,11 @@ TransientPropagationModule::TransientPropagationModule(Configuration& config,
         throw InvalidValueError(config_, "induction_matrix", "Odd number of pixels in x and y required.");
     }
 
+    if(adaptive_timestep_ && timestep_min_ > timestep_max_) {
+        throw InvalidCombinationError(
+            config_, {"timestep_min", "timestep_max"}, "Minimum timestep has to be smaller than maximum timestep.");
+    }
+
     output_plots_ = config_.get<bool>("output_plots");
     boltzmann_kT_ = Units::get(8.6173e-5, "eV/K") * temperature_;
 
@@ -315,12 +337,26 @@ TransientPropagationModule::propagate(Event* event,
     Eigen::Vector3d last_position = position;
     bool within_sensor = true;
     bool is_alive = true;
+    unsigned int integration_steps = 0;
+    PITimestepController timestep_control(target_spatial_precision_, timestep_safety_factor_, timestep_min_, timestep_max_);
     while(within_sensor && (initial_time + runge_kutta.getTime()) < integration_time_ && is_alive) {
         // Save previous position and time
         last_position = position;
+        auto last_time = runge_kutta.getTime();
 
         // Execute a Runge Kutta step
         auto step = runge_kutta.step();
+        auto timestep = runge_kutta.getTimeStep();
+        ++integration_steps;
+
+        // With adaptive timesteps, reject steps exceeding the target precision unless the minimum timestep has been reached
+        auto uncertainty = step.error.norm();
+        if(adaptive_timestep_ && timestep_control.reject(uncertainty, timestep)) {
+            runge_kutta.setValue(last_position);
+            runge_kutta.setTime(last_time);
+            runge_kutta.setTimeStep(timestep);
+            continue;
+        }
 
         // Get the current result
         position = runge_kutta.getValue();
@@ -330,7 +366,7 @@ TransientPropagationModule::propagate(Event* event,
         auto doping = detector_->getDopingConcentration(static_cast<ROOT::Math::XYZPoint>(position));
 
         // Apply diffusion step
-        auto diffusion = carrier_diffusion(std::sqrt(efield.Mag2()), doping, timestep_);
+        auto diffusion = carrier_diffusion(std::sqrt(efield.Mag2()), doping, timestep);
         position += diffusion;
         runge_kutta.setValue(position);
 
@@ -338,7 +374,7 @@ TransientPropagationModule::propagate(Event* event,
         is_alive = !recombination_(type,
                                    detector_->getDopingConcentration(static_cast<ROOT::Math::XYZPoint>(position)),
                                    survival(event->getRandomEngine()),
-                                   timestep_);
+                                   timestep);
 
         // Update step length histogram
         if(output_plots_) {
@@ -417,9 +453,15 @@ TransientPropagationModule::propagate(Event* event,
                 LOG(TRACE) << "Pixel " << pixel_index << " dPhi = " << (ramo - last_ramo) << ", induced " << type
                            << " q = " << Units::display(induced, "e");
 
-                // Create pulse if it doesn't exist. Store induced charge in the returned pulse iterator
+                // Create pulse if it doesn't exist. Store induced charge in the returned pulse iterator. With adaptive
+                // timesteps, the charge is distributed over all pulse bins covered by the step.
                 auto pixel_map_iterator = pixel_map.emplace(pixel_index, Pulse(timestep_));
-                pixel_map_iterator.first->second.addCharge(induced, initial_time + runge_kutta.getTime());
+                if(adaptive_timestep_) {
+                    pixel_map_iterator.first->second.addCharge(
+                        induced, initial_time + last_time, initial_time + runge_kutta.getTime());
+                } else {
+                    pixel_map_iterator.first->second.addCharge(induced, initial_time + runge_kutta.getTime());
+                }
 
                 if(output_plots_) {
                     potential_difference_->Fill(std::fabs(ramo - last_ramo));
@@ -432,8 +474,17 @@ TransientPropagationModule::propagate(Event* event,
                 }
             }
         }
+
+        // Adapt the timestep to match the target precision, independently of the pulse binning
+        if(adaptive_timestep_) {
+            runge_kutta.setTimeStep(timestep_control.next(uncertainty, timestep));
+        }
     }
 
+    total_groups_++;
+    total_integration_steps_ += integration_steps;
+    total_rejected_steps_ += timestep_control.getRejectedSteps();
+
     // Return the final position of the propagated charge
     return std::make_tuple(static_cast<ROOT::Math::XYZPoint>(position), initial_time + runge_kutta.getTime(), is_alive);
 }
@@ -448,4 +499,8 @@ void TransientPropagationModule::finalize() {
         induced_charge_e_histo_->Write();
         induced_charge_h_histo_->Write();
     }
+
+    if(adaptive_timestep_) {
+        log_timestep_statistics(total_groups_, total_integration_steps_, total_rejected_steps_);
+    }
 }
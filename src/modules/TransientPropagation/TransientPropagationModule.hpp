@@ -7,6 +7,7 @@
  * Intergovernmental Organization or submit itself to any jurisdiction.
  */
 
+#include <atomic>
 #include <string>
 
 #include <Math/DisplacementVector2D.h>
@@ -91,6 +92,8 @@ namespace allpix {
 
         // Local copies of configuration parameters to avoid costly lookup:
         double temperature_{}, timestep_{}, integration_time_{};
+        bool adaptive_timestep_{};
+        double timestep_min_{}, timestep_max_{}, timestep_safety_factor_{}, target_spatial_precision_{};
         bool output_plots_{};
         ROOT::Math::DisplacementVector2D<ROOT::Math::Cartesian2D<int>> matrix_;
         unsigned int charge_per_step_{};
@@ -115,5 +118,10 @@ namespace allpix {
         Histogram<TH1D> step_length_histo_;
         Histogram<TH1D> drift_time_histo_;
         Histogram<TH1D> recombine_histo_;
+
+        // Statistics of the adaptive time step control
+        std::atomic<long unsigned int> total_groups_{};
+        std::atomic<long unsigned int> total_integration_steps_{};
+        std::atomic<long unsigned int> total_rejected_steps_{};
     };
 } // namespace allpix
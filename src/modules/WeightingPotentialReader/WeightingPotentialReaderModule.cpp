@@ -24,6 +24,7 @@
 #include "core/geometry/DetectorModel.hpp"
 #include "core/utils/log.h"
 #include "core/utils/unit.h"
+#include "tools/field_reduction.h"
 
 using namespace allpix;
 
@@ -48,13 +49,68 @@ void WeightingPotentialReaderModule::initialize() {
     if(field_model == WeightingPotential::MESH) {
         auto field_data = read_field(thickness_domain);
 
+        // Reduce the potential grid if it does not change along x and/or y. The reduced potential remains limited to the
+        // original extent of the map, so neighboring pixels along the reduced axis are not affected.
+        std::array<bool, 2> reduced_axes{};
+        if(config_.get<bool>("reduce_field_dimensions", false)) {
+            reduced_axes =
+                find_invariant_axes(field_data, FieldQuantity::SCALAR, config_.get<double>("reduction_tolerance", 1e-6));
+            if(reduced_axes[0] || reduced_axes[1]) {
+                field_data = collapse_axes(field_data, FieldQuantity::SCALAR, reduced_axes);
+                LOG(INFO) << "Weighting potential is invariant along" << (reduced_axes[0] ? " x" : "")
+                          << (reduced_axes[1] ? " y" : "") << ", reduced to " << field_data.getDimensions()[0] << "x"
+                          << field_data.getDimensions()[1] << "x" << field_data.getDimensions()[2] << " cells";
+            }
+        }
+
+        // Only store the upper half or quadrant of the potential if it is symmetric with respect to the reference pixel:
+        auto dimensions = field_data.getDimensions();
+        auto full_field = field_data;
+        std::array<bool, 2> mirrored_axes{};
+        if(config_.get<bool>("mirror_symmetry", false)) {
+            mirrored_axes =
+                find_symmetric_axes(field_data, FieldQuantity::SCALAR, config_.get<double>("symmetry_tolerance", 1e-6));
+            for(size_t axis = 0; axis < 2; ++axis) {
+                if(dimensions.at(axis) > 1 && !mirrored_axes.at(axis)) {
+                    throw InvalidValueError(config_,
+                                            "mirror_symmetry",
+                                            std::string("weighting potential is not mirror-symmetric along ") +
+                                                (axis == 0 ? "x" : "y") + " within the configured tolerance");
+                }
+            }
+            field_data = mirror_axes(field_data, FieldQuantity::SCALAR, mirrored_axes);
+            LOG(INFO) << "Weighting potential is mirror-symmetric, storing " << field_data.getDimensions()[0] << "x"
+                      << field_data.getDimensions()[1] << "x" << field_data.getDimensions()[2] << " cells";
+        }
+
         // Set the field grid, provide scale factors as fraction of the pixel pitch for correct scaling:
         detector_->setWeightingPotentialGrid(field_data.getData(),
-                                             field_data.getDimensions(),
+                                             dimensions,
                                              std::array<double, 2>{{field_data.getSize()[0] / model->getPixelSize().x(),
                                                                     field_data.getSize()[1] / model->getPixelSize().y()}},
                                              std::array<double, 2>{{0, 0}},
-                                             thickness_domain);
+                                             thickness_domain,
+                                             reduced_axes,
+                                             mirrored_axes);
+
+        // Verify that lookups in all quadrants of a mirrored potential reproduce the full potential map:
+        if(mirrored_axes[0] || mirrored_axes[1]) {
+            auto center = model->getPixelCenter(0, 0);
+            auto deviation = find_mirror_deviation(full_field,
+                                                   FieldQuantity::SCALAR,
+                                                   {{full_field.getSize()[0], full_field.getSize()[1]}},
+                                                   thickness_domain,
+                                                   [&](double x, double y, double z) {
+                                                       return detector_->getWeightingPotential(
+                                                           ROOT::Math::XYZPoint(x + center.x(), y + center.y(), z), {0, 0});
+                                                   });
+            if(deviation > config_.get<double>("symmetry_tolerance", 1e-6)) {
+                LOG(WARNING) << "Lookups of the mirrored weighting potential deviate from the full map by up to "
+                             << deviation << " of its maximum value";
+            } else {
+                LOG(DEBUG) << "Lookups of the mirrored weighting potential match the full map in all quadrants";
+            }
+        }
     } else if(field_model == WeightingPotential::PAD) {
         LOG(TRACE) << "Adding weighting potential from pad in plane condenser";
 
@@ -199,8 +255,9 @@ FieldData<double> WeightingPotentialReaderModule::read_field(std::pair<double, d
     try {
         LOG(TRACE) << "Fetching weighting potential from init file";
 
-        // Get field from file
-        auto field_data = field_parser_.getByFileName(config_.getPath("file_name", true));
+        // Get field from file, storing parsed INIT files in the cache directory if requested
+        auto cache_directory = config_.has("field_cache_directory") ? config_.getPath("field_cache_directory") : "";
+        auto field_data = field_parser_.getByFileName(config_.getPath("file_name", true), "", cache_directory);
 
         // Check maximum/minimum values of the potential:
         auto elements = std::minmax_element(field_data.getData()->begin(), field_data.getData()->end());
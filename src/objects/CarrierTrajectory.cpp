@@ -0,0 +1,66 @@
+/**
+ * @file
+ * @brief Implementation of charge carrier trajectory object
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "CarrierTrajectory.hpp"
+
+#include "objects/exceptions.h"
+
+using namespace allpix;
+
+CarrierTrajectory::CarrierTrajectory(ROOT::Math::XYZPoint local_position,
+                                     ROOT::Math::XYZPoint global_position,
+                                     CarrierType type,
+                                     unsigned int charge,
+                                     double local_time,
+                                     double global_time,
+                                     std::vector<ROOT::Math::XYZPoint> points,
+                                     std::vector<double> times,
+                                     const DepositedCharge* deposited_charge)
+    : SensorCharge(std::move(local_position), std::move(global_position), type, charge, local_time, global_time),
+      points_(std::move(points)), times_(std::move(times)) {
+    deposited_charge_ = PointerWrapper<DepositedCharge>(deposited_charge);
+}
+
+const std::vector<ROOT::Math::XYZPoint>& CarrierTrajectory::getPoints() const {
+    return points_;
+}
+
+const std::vector<double>& CarrierTrajectory::getTimes() const {
+    return times_;
+}
+
+/**
+ * @throws MissingReferenceException If the pointed object is not in scope
+ *
+ * Object is stored as TRef and can only be accessed if pointed object is in scope
+ */
+const DepositedCharge* CarrierTrajectory::getDepositedCharge() const {
+    auto* deposited_charge = deposited_charge_.load(local_objects);
+    if(deposited_charge == nullptr) {
+        throw MissingReferenceException(typeid(*this), typeid(DepositedCharge));
+    }
+    return deposited_charge;
+}
+
+void CarrierTrajectory::print(std::ostream& out) const {
+    out << "--- Charge carrier trajectory information\n";
+    SensorCharge::print(out);
+    out << "Trajectory points: " << points_.size() << "\n";
+    if(!points_.empty()) {
+        out << "Final local position: (" << points_.back().X() << ", " << points_.back().Y() << ", " << points_.back().Z()
+            << ") mm after " << times_.back() << " ns\n";
+    }
+}
+
+void CarrierTrajectory::loadHistory(const LocalObjectTable* local_objects) {
+    deposited_charge_.load(local_objects);
+}
+void CarrierTrajectory::petrifyHistory(const LocalReferenceMap* local_references) {
+    deposited_charge_.store(local_references);
+}
@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @brief Definition of charge carrier trajectory object
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_CARRIER_TRAJECTORY_H
+#define ALLPIX_CARRIER_TRAJECTORY_H
+
+#include <vector>
+
+#include <Math/Point3D.h>
+
+#include "DepositedCharge.hpp"
+#include "SensorCharge.hpp"
+
+namespace allpix {
+    /**
+     * @ingroup Objects
+     * @brief Trajectory of a set of charges during its propagation through the sensor
+     *
+     * The position and time of the object refer to the start of the propagation. The trajectory itself is stored as a list
+     * of local positions sampled at fixed time intervals, together with the propagation time at each of these points.
+     */
+    class CarrierTrajectory : public SensorCharge {
+    public:
+        /**
+         * @brief Construct the trajectory of a set of charges
+         * @param local_position Local position of the set of charges at the start of the propagation
+         * @param global_position Global position of the set of charges at the start of the propagation
+         * @param type Type of the propagated carrier
+         * @param charge Total charge propagated
+         * @param local_time Time of the start of the propagation, local reference frame
+         * @param global_time Time of the start of the propagation, global reference frame
+         * @param points Local positions along the trajectory
+         * @param times Propagation time at the respective positions, relative to the start of the propagation
+         * @param deposited_charge Optional pointer to related deposited charge
+         */
+        CarrierTrajectory(ROOT::Math::XYZPoint local_position,
+                          ROOT::Math::XYZPoint global_position,
+                          CarrierType type,
+                          unsigned int charge,
+                          double local_time,
+                          double global_time,
+                          std::vector<ROOT::Math::XYZPoint> points,
+                          std::vector<double> times,
+                          const DepositedCharge* deposited_charge = nullptr);
+
+        /**
+         * @brief Get the local positions along the trajectory
+         * @return List of sampled local positions
+         */
+        const std::vector<ROOT::Math::XYZPoint>& getPoints() const;
+
+        /**
+         * @brief Get the propagation time at the sampled positions
+         * @return List of times relative to the start of the propagation
+         */
+        const std::vector<double>& getTimes() const;
+
+        /**
+         * @brief Get related deposited charge
+         * @return Pointer to possible deposited charge
+         */
+        const DepositedCharge* getDepositedCharge() const;
+
+        /**
+         * @brief Print an ASCII representation of CarrierTrajectory to the given stream
+         * @param out Stream to print to
+         */
+        void print(std::ostream& out) const override;
+
+        /**
+         * @brief ROOT class definition
+         */
+        ClassDefOverride(CarrierTrajectory, 1); // NOLINT
+        /**
+         * @brief Default constructor for ROOT I/O
+         */
+        CarrierTrajectory() = default;
+
+        void loadHistory(const LocalObjectTable* local_objects) override;
+        void petrifyHistory(const LocalReferenceMap* local_references) override;
+
+    private:
+        std::vector<ROOT::Math::XYZPoint> points_;
+        std::vector<double> times_;
+
+        PointerWrapper<DepositedCharge> deposited_charge_;
+    };
+
+    /**
+     * @brief Typedef for message carrying charge carrier trajectories
+     */
+    using CarrierTrajectoryMessage = Message<CarrierTrajectory>;
+} // namespace allpix
+
+#endif /* ALLPIX_CARRIER_TRAJECTORY_H */
@@ -30,7 +30,7 @@ DepositedCharge::DepositedCharge(ROOT::Math::XYZPoint local_position,
  * Object is stored as TRef and can only be accessed if pointed object is in scope
  */
 const MCParticle* DepositedCharge::getMCParticle() const {
-    auto* mc_particle = mc_particle_.get();
+    auto* mc_particle = mc_particle_.load(local_objects);
     if(mc_particle == nullptr) {
         throw MissingReferenceException(typeid(*this), typeid(MCParticle));
     }
@@ -46,9 +46,9 @@ void DepositedCharge::print(std::ostream& out) const {
     SensorCharge::print(out);
 }
 
-void DepositedCharge::loadHistory() {
-    mc_particle_.get();
+void DepositedCharge::loadHistory(const LocalObjectTable* local_objects) {
+    mc_particle_.load(local_objects);
 }
-void DepositedCharge::petrifyHistory() {
-    mc_particle_.store();
+void DepositedCharge::petrifyHistory(const LocalReferenceMap* local_references) {
+    mc_particle_.store(local_references);
 }
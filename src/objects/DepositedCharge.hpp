@@ -70,8 +70,8 @@ namespace allpix {
          */
         DepositedCharge() = default;
 
-        void loadHistory() override;
-        void petrifyHistory() override;
+        void loadHistory(const LocalObjectTable* local_objects) override;
+        void petrifyHistory(const LocalReferenceMap* local_references) override;
 
     private:
         PointerWrapper<MCParticle> mc_particle_;
@@ -20,6 +20,7 @@
 #pragma link C++ class allpix::MCParticle + ;
 #pragma link C++ class allpix::SensorCharge + ;
 #pragma link C++ class allpix::PropagatedCharge + ;
+#pragma link C++ class allpix::CarrierTrajectory + ;
 #pragma link C++ class allpix::DepositedCharge + ;
 #pragma link C++ class allpix::Pixel + ;
 #pragma link C++ class allpix::PixelCharge + ;
@@ -78,14 +78,14 @@ void MCParticle::setParent(const MCParticle* mc_particle) {
  * Object is stored as TRef and can only be accessed if pointed object is in scope
  */
 const MCParticle* MCParticle::getParent() const {
-    return parent_.get();
+    return parent_.load(local_objects);
 }
 
 /**
  * Object is stored as TRef and can only be accessed if pointed object is in scope
  */
 const MCParticle* MCParticle::getPrimary() const {
-    auto* parent = parent_.get();
+    auto* parent = parent_.load(local_objects);
     return (parent == nullptr ? this : parent->getPrimary());
 }
 
@@ -97,7 +97,7 @@ void MCParticle::setTrack(const MCTrack* mc_track) {
  * Object is stored as TRef and can only be accessed if pointed object is in scope
  */
 const MCTrack* MCParticle::getTrack() const {
-    return track_.get();
+    return track_.load(local_objects);
 }
 
 void MCParticle::print(std::ostream& out) const {
@@ -149,11 +149,11 @@ void MCParticle::print(std::ostream& out) const {
     out << std::setfill('-') << std::setw(largest_output) << "" << std::setfill(' ') << std::endl;
 }
 
-void MCParticle::loadHistory() {
-    parent_.get();
-    track_.get();
+void MCParticle::loadHistory(const LocalObjectTable* local_objects) {
+    parent_.load(local_objects);
+    track_.load(local_objects);
 }
-void MCParticle::petrifyHistory() {
-    parent_.store();
-    track_.store();
+void MCParticle::petrifyHistory(const LocalReferenceMap* local_references) {
+    parent_.store(local_references);
+    track_.store(local_references);
 }
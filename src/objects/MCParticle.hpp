@@ -136,8 +136,8 @@ namespace allpix {
          */
         void print(std::ostream& out) const override;
 
-        void loadHistory() override;
-        void petrifyHistory() override;
+        void loadHistory(const LocalObjectTable* local_objects) override;
+        void petrifyHistory(const LocalReferenceMap* local_references) override;
 
     private:
         ROOT::Math::XYZPoint local_start_point_{};
@@ -74,7 +74,7 @@ std::string MCTrack::getCreationProcessName() const {
  * Object is stored as TRef and can only be accessed if pointed object is in scope
  */
 const MCTrack* MCTrack::getParent() const {
-    return parent_.get();
+    return parent_.load(local_objects);
 }
 
 void MCTrack::setParent(const MCTrack* mc_track) {
@@ -119,9 +119,9 @@ void MCTrack::print(std::ostream& out) const {
     out << std::setfill('-') << std::setw(largest_output) << "" << std::setfill(' ') << std::endl;
 }
 
-void MCTrack::loadHistory() {
-    parent_.get();
+void MCTrack::loadHistory(const LocalObjectTable* local_objects) {
+    parent_.load(local_objects);
 }
-void MCTrack::petrifyHistory() {
-    parent_.store();
+void MCTrack::petrifyHistory(const LocalReferenceMap* local_references) {
+    parent_.store(local_references);
 }
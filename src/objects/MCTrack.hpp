@@ -135,8 +135,8 @@ namespace allpix {
          */
         MCTrack() = default;
 
-        void loadHistory() override;
-        void petrifyHistory() override;
+        void loadHistory(const LocalObjectTable* local_objects) override;
+        void petrifyHistory(const LocalReferenceMap* local_references) override;
 
     private:
         ROOT::Math::XYZPoint start_point_{};
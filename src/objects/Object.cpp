@@ -11,6 +11,23 @@
 
 using namespace allpix;
 
+const std::pair<int, int>* Object::findLocalReference(const LocalReferenceMap* local_references, const Object* object) {
+    if(local_references == nullptr) {
+        return nullptr;
+    }
+    auto it = local_references->find(object);
+    return it == local_references->end() ? nullptr : &it->second;
+}
+
+Object* Object::findLocalObject(const LocalObjectTable* local_objects, int collection, int index) {
+    if(local_objects == nullptr || collection < 0 || index < 0 ||
+       static_cast<size_t>(collection) >= local_objects->size() ||
+       static_cast<size_t>(index) >= (*local_objects)[static_cast<size_t>(collection)].size()) {
+        return nullptr;
+    }
+    return (*local_objects)[static_cast<size_t>(collection)][static_cast<size_t>(index)];
+}
+
 std::ostream& allpix::operator<<(std::ostream& out, const Object& obj) {
     obj.print(out);
     return out;
@@ -18,6 +18,9 @@
 #include <atomic>
 #include <iostream>
 #include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <TObject.h>
 #include <TRef.h>
@@ -63,14 +66,29 @@ namespace allpix {
          */
         ClassDefOverride(Object, 4); // NOLINT
 
+        /**
+         * @brief Map from objects to their event-local reference, given as collection and index within the collection
+         */
+        using LocalReferenceMap = std::unordered_map<const Object*, std::pair<int, int>>;
+        /**
+         * @brief Table of all objects of an event, indexed by collection and index within the collection
+         */
+        using LocalObjectTable = std::vector<std::vector<Object*>>;
+
         /**
          * @brief Resolve all the history to standard pointers
+         * @param local_objects Table of all objects of the event to resolve event-local references with, nullptr if the
+         * history has been stored with TRefs only
          */
-        virtual void loadHistory() = 0;
+        virtual void loadHistory(const LocalObjectTable* local_objects) = 0;
         /**
          * @brief Petrify all the pointers to prepare for persistent storage
+         * @param local_references Map of event-local references for all objects to be stored, nullptr to store TRefs only
+         *
+         * Objects which are found in the map are referenced by their collection and index instead of a TRef, which avoids
+         * the registration of the objects in the process ID tables of ROOT.
          */
-        virtual void petrifyHistory() = 0;
+        virtual void petrifyHistory(const LocalReferenceMap* local_references) = 0;
 
         void markForStorage() {
             // Using bit 14 of the TObject bit field, unused by ROOT:
@@ -93,6 +111,23 @@ namespace allpix {
             std::cout << std::endl;
         }
 
+        /**
+         * @brief Look up the event-local reference of an object
+         * @param local_references Map of event-local references, may be nullptr
+         * @param object           Object to look up
+         * @return Pointer to the collection and index of the object, nullptr if no map is given or the object is unknown
+         */
+        static const std::pair<int, int>* findLocalReference(const LocalReferenceMap* local_references,
+                                                             const Object* object);
+        /**
+         * @brief Resolve an event-local reference to the object it refers to
+         * @param local_objects Table of all objects of the event, may be nullptr
+         * @param collection    Collection of the referred object
+         * @param index         Index of the referred object within the collection
+         * @return Pointer to the object, nullptr if the reference cannot be resolved
+         */
+        static Object* findLocalObject(const LocalObjectTable* local_objects, int collection, int index);
+
     public:
         template <class T> class BaseWrapper {
         public:
@@ -134,16 +169,28 @@ namespace allpix {
 
             /**
              * @brief Function to construct TRef object for wrapped pointer for persistent storage
+             * @param local_references Map of event-local references for all objects to be stored, nullptr to store a TRef
              *
-             * @note A TRef is only constructed if the object the wrapped pointer is referring to has been marked for storage
+             * @note A reference is only constructed if the object the wrapped pointer is referring to has been marked for
+             * storage. If the object is found in the map of event-local references, its collection and index are stored
+             * instead of a TRef.
              */
-            void store() {
+            void store(const LocalReferenceMap* local_references) {
                 if(markedForStorage()) {
-                    ref_ = get();
+                    const auto* local = findLocalReference(local_references, get());
+                    if(local != nullptr) {
+                        ref_ = TRef();
+                        local_collection_ = local->first;
+                        local_index_ = local->second;
+                    } else {
+                        ref_ = get();
+                        local_collection_ = -1;
+                        local_index_ = -1;
+                    }
                 }
             }
 
-            ClassDef(BaseWrapper, 1); // NOLINT
+            ClassDef(BaseWrapper, 2); // NOLINT
 
         protected:
             /**
@@ -159,6 +206,9 @@ namespace allpix {
 
             mutable T* ptr_{}; //! transient value
             TRef ref_{};
+            // Event-local reference, used instead of the TRef if the collection is not negative
+            int local_collection_{-1};
+            int local_index_{-1};
         };
 
         template <class T> class PointerWrapper : public BaseWrapper<T> {
@@ -210,17 +260,33 @@ namespace allpix {
             /**
              * @brief Implementation of base class lazy loading mechanism with thread-safe call_once
              * @return Pointer to object
+             * @note Event-local references can only be resolved by \ref load, this returns nullptr until then
+             */
+            T* get() const override { return load(nullptr); };
+
+            /**
+             * @brief Resolve the wrapped pointer from the TRef object or the event-local reference
+             * @param local_objects Table of all objects of the event to resolve event-local references with, may be nullptr
+             * @return Pointer to object
              */
-            T* get() const override {
-                // Lazy loading of pointer from TRef
+            T* load(const LocalObjectTable* local_objects) const {
                 if(!this->loaded_) {
+                    // Keep event-local references unresolved until the table of event objects is provided
+                    if(this->local_collection_ >= 0 && local_objects == nullptr) {
+                        return nullptr;
+                    }
                     std::call_once(load_flag_, [&]() {
-                        this->ptr_ = static_cast<T*>(this->ref_.GetObject());
+                        if(this->local_collection_ < 0) {
+                            this->ptr_ = static_cast<T*>(this->ref_.GetObject());
+                        } else {
+                            this->ptr_ = static_cast<T*>(
+                                findLocalObject(local_objects, this->local_collection_, this->local_index_));
+                        }
                         this->loaded_ = true;
                     });
                 }
                 return this->ptr_;
-            };
+            }
 
             ClassDefOverride(PointerWrapper, 1); // NOLINT
 
@@ -116,7 +116,7 @@ std::vector<const MCParticle*> PixelCharge::getMCParticles() const {
 std::vector<const MCParticle*> PixelCharge::getPrimaryMCParticles() const {
     std::vector<const MCParticle*> primary_particles;
     for(const auto& mc_particle : mc_particles_) {
-        auto* particle = mc_particle.get();
+        auto* particle = mc_particle.load(local_objects);
         if(particle == nullptr) {
             throw MissingReferenceException(typeid(*this), typeid(MCParticle));
         }
@@ -148,11 +148,16 @@ void PixelCharge::print(std::ostream& out) const {
         << "Global time:" << global_time_ << " ns\n";
 }
 
-void PixelCharge::loadHistory() {
-    std::for_each(propagated_charges_.begin(), propagated_charges_.end(), [](auto& n) { n.get(); });
-    std::for_each(mc_particles_.begin(), mc_particles_.end(), [](auto& n) { n.get(); });
+void PixelCharge::compressPulse(const Pulse::StorageFormat& format) {
+    pulse_.compress(format);
 }
-void PixelCharge::petrifyHistory() {
-    std::for_each(propagated_charges_.begin(), propagated_charges_.end(), [](auto& n) { n.store(); });
-    std::for_each(mc_particles_.begin(), mc_particles_.end(), [](auto& n) { n.store(); });
+
+void PixelCharge::loadHistory(const LocalObjectTable* local_objects) {
+    pulse_.expand();
+    std::for_each(propagated_charges_.begin(), propagated_charges_.end(), [&](auto& n) { n.load(local_objects); });
+    std::for_each(mc_particles_.begin(), mc_particles_.end(), [&](auto& n) { n.load(local_objects); });
+}
+void PixelCharge::petrifyHistory(const LocalReferenceMap* local_references) {
+    std::for_each(propagated_charges_.begin(), propagated_charges_.end(), [&](auto& n) { n.store(local_references); });
+    std::for_each(mc_particles_.begin(), mc_particles_.end(), [&](auto& n) { n.store(local_references); });
 }
@@ -98,6 +98,12 @@ namespace allpix {
          */
         const Pulse& getPulse() const;
 
+        /**
+         * @brief Compress the stored representation of the charge pulse
+         * @param format Format to compress the pulse with
+         */
+        void compressPulse(const Pulse::StorageFormat& format);
+
         /**
          * @brief Get time after start of event in global reference frame
          * @return Time from start event
@@ -125,8 +131,8 @@ namespace allpix {
          */
         PixelCharge() = default;
 
-        void loadHistory() override;
-        void petrifyHistory() override;
+        void loadHistory(const LocalObjectTable* local_objects) override;
+        void petrifyHistory(const LocalReferenceMap* local_references) override;
 
     private:
         Pixel pixel_;
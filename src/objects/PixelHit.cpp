@@ -48,7 +48,7 @@ Pixel::Index PixelHit::getIndex() const {
  * Object is stored as TRef and can only be accessed if pointed object is in scope
  */
 const PixelCharge* PixelHit::getPixelCharge() const {
-    auto* pixel_charge = pixel_charge_.get();
+    auto* pixel_charge = pixel_charge_.load(local_objects);
     if(pixel_charge == nullptr) {
         throw MissingReferenceException(typeid(*this), typeid(PixelCharge));
     }
@@ -82,7 +82,7 @@ std::vector<const MCParticle*> PixelHit::getMCParticles() const {
 std::vector<const MCParticle*> PixelHit::getPrimaryMCParticles() const {
     std::vector<const MCParticle*> primary_particles;
     for(const auto& mc_particle : mc_particles_) {
-        auto* particle = mc_particle.get();
+        auto* particle = mc_particle.load(local_objects);
         if(particle == nullptr) {
             throw MissingReferenceException(typeid(*this), typeid(MCParticle));
         }
@@ -103,11 +103,11 @@ void PixelHit::print(std::ostream& out) const {
         << this->getLocalTime() << ", " << this->getGlobalTime();
 }
 
-void PixelHit::loadHistory() {
-    pixel_charge_.get();
-    std::for_each(mc_particles_.begin(), mc_particles_.end(), [](auto& n) { n.get(); });
+void PixelHit::loadHistory(const LocalObjectTable* local_objects) {
+    pixel_charge_.load(local_objects);
+    std::for_each(mc_particles_.begin(), mc_particles_.end(), [&](auto& n) { n.load(local_objects); });
 }
-void PixelHit::petrifyHistory() {
-    pixel_charge_.store();
-    std::for_each(mc_particles_.begin(), mc_particles_.end(), [](auto& n) { n.store(); });
+void PixelHit::petrifyHistory(const LocalReferenceMap* local_references) {
+    pixel_charge_.store(local_references);
+    std::for_each(mc_particles_.begin(), mc_particles_.end(), [&](auto& n) { n.store(local_references); });
 }
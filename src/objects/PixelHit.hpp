@@ -102,8 +102,8 @@ namespace allpix {
          */
         PixelHit() = default;
 
-        void loadHistory() override;
-        void petrifyHistory() override;
+        void loadHistory(const LocalObjectTable* local_objects) override;
+        void petrifyHistory(const LocalReferenceMap* local_references) override;
 
     private:
         Pixel pixel_;
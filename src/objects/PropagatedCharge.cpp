@@ -7,6 +7,7 @@
  * Intergovernmental Organization or submit itself to any jurisdiction.
  */
 
+#include <algorithm>
 #include <numeric>
 
 #include "PropagatedCharge.hpp"
@@ -57,7 +58,7 @@ PropagatedCharge::PropagatedCharge(ROOT::Math::XYZPoint local_position,
  * Object is stored as TRef and can only be accessed if pointed object is in scope
  */
 const DepositedCharge* PropagatedCharge::getDepositedCharge() const {
-    auto* deposited_charge = deposited_charge_.get();
+    auto* deposited_charge = deposited_charge_.load(local_objects);
     if(deposited_charge == nullptr) {
         throw MissingReferenceException(typeid(*this), typeid(DepositedCharge));
     }
@@ -70,27 +71,32 @@ const DepositedCharge* PropagatedCharge::getDepositedCharge() const {
  * Object is stored as TRef and can only be accessed if pointed object is in scope
  */
 const MCParticle* PropagatedCharge::getMCParticle() const {
-    auto* mc_particle = mc_particle_.get();
+    auto* mc_particle = mc_particle_.load(local_objects);
     if(mc_particle == nullptr) {
         throw MissingReferenceException(typeid(*this), typeid(MCParticle));
     }
     return mc_particle;
 }
 
-std::map<Pixel::Index, Pulse> PropagatedCharge::getPulses() const {
+const std::map<Pixel::Index, Pulse>& PropagatedCharge::getPulses() const {
     return pulses_;
 }
 
+void PropagatedCharge::compressPulses(const Pulse::StorageFormat& format) {
+    std::for_each(pulses_.begin(), pulses_.end(), [&format](auto& n) { n.second.compress(format); });
+}
+
 void PropagatedCharge::print(std::ostream& out) const {
     out << "--- Propagated charge information\n";
     SensorCharge::print(out);
 }
 
-void PropagatedCharge::loadHistory() {
-    deposited_charge_.get();
-    mc_particle_.get();
+void PropagatedCharge::loadHistory(const LocalObjectTable* local_objects) {
+    deposited_charge_.load(local_objects);
+    mc_particle_.load(local_objects);
+    std::for_each(pulses_.begin(), pulses_.end(), [](auto& n) { n.second.expand(); });
 }
-void PropagatedCharge::petrifyHistory() {
-    deposited_charge_.store();
-    mc_particle_.store();
+void PropagatedCharge::petrifyHistory(const LocalReferenceMap* local_references) {
+    deposited_charge_.store(local_references);
+    mc_particle_.store(local_references);
 }
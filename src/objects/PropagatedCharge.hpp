@@ -77,9 +77,15 @@ namespace allpix {
 
         /**
          * @brief Get related induced pulses
-         * @return Map with induced pulses if available
+         * @return Constant reference to the map with induced pulses if available
          */
-        std::map<Pixel::Index, Pulse> getPulses() const;
+        const std::map<Pixel::Index, Pulse>& getPulses() const;
+
+        /**
+         * @brief Compress the stored representation of all induced pulses
+         * @param format Format to compress the pulses with
+         */
+        void compressPulses(const Pulse::StorageFormat& format);
 
         /**
          * @brief Print an ASCII representation of PropagatedCharge to the given stream
@@ -96,8 +102,8 @@ namespace allpix {
          */
         PropagatedCharge() = default;
 
-        void loadHistory() override;
-        void petrifyHistory() override;
+        void loadHistory(const LocalObjectTable* local_objects) override;
+        void petrifyHistory(const LocalReferenceMap* local_references) override;
 
     private:
         PointerWrapper<DepositedCharge> deposited_charge_;
@@ -10,14 +10,19 @@
 #include "Pulse.hpp"
 #include "objects/exceptions.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <numeric>
+#include <utility>
 
 using namespace allpix;
 
 Pulse::Pulse(double time_bin) : bin_(time_bin), initialized_(true) {}
 
 void Pulse::addCharge(double charge, double time) {
+    expand();
+
     // For uninitialized pulses, store all charge in the first bin:
     auto bin = (initialized_ ? static_cast<size_t>(std::lround(time / bin_)) : 0);
 
@@ -28,13 +33,40 @@ void Pulse::addCharge(double charge, double time) {
     pulse_.at(bin) += charge;
 }
 
+void Pulse::addCharge(double charge, double start_time, double end_time) {
+    expand();
+
+    // Treat uninitialized pulses and empty intervals like charge induced at a single point in time:
+    if(!initialized_ || end_time <= start_time) {
+        addCharge(charge, end_time);
+        return;
+    }
+
+    // Bin i covers the time interval [(i - 0.5) * bin, (i + 0.5) * bin):
+    auto first_bin = static_cast<size_t>(std::lround(start_time / bin_));
+    auto last_bin = static_cast<size_t>(std::lround(end_time / bin_));
+    if(last_bin >= pulse_.size()) {
+        pulse_.resize(last_bin + 1);
+    }
+
+    auto duration = end_time - start_time;
+    for(auto bin = first_bin; bin <= last_bin; ++bin) {
+        auto lower = std::max(start_time, (static_cast<double>(bin) - 0.5) * bin_);
+        auto upper = std::min(end_time, (static_cast<double>(bin) + 0.5) * bin_);
+        if(upper > lower) {
+            pulse_.at(bin) += charge * (upper - lower) / duration;
+        }
+    }
+}
+
 int Pulse::getCharge() const {
-    double charge = std::accumulate(pulse_.begin(), pulse_.end(), 0.0);
+    const auto& pulse = getPulse();
+    double charge = std::accumulate(pulse.begin(), pulse.end(), 0.0);
     return static_cast<int>(std::round(charge));
 }
 
 const std::vector<double>& Pulse::getPulse() const {
-    return pulse_;
+    return (storage_ == Storage::DENSE ? pulse_ : decoded_);
 }
 
 double Pulse::getBinning() const {
@@ -47,6 +79,7 @@ bool Pulse::isInitialized() const {
 
 Pulse& Pulse::operator+=(const Pulse& rhs) {
     auto rhs_pulse = rhs.getPulse();
+    expand();
 
     // Allow to initialize uninitialized pulse
     if(!this->initialized_) {
@@ -71,3 +104,84 @@ Pulse& Pulse::operator+=(const Pulse& rhs) {
 
     return *this;
 }
+
+void Pulse::compress(const StorageFormat& format) {
+    // Always start from the dense layout to allow changing the format of compressed pulses:
+    expand();
+    if(format.storage == Storage::DENSE) {
+        return;
+    }
+
+    bins_ = static_cast<unsigned int>(pulse_.size());
+    size_t previous_end = 0;
+    size_t bin = 0;
+    while(bin < pulse_.size()) {
+        if(std::fabs(pulse_[bin]) <= format.threshold) {
+            ++bin;
+            continue;
+        }
+
+        // Store the run of bins above threshold together with its distance to the previous run:
+        auto start = bin;
+        for(; bin < pulse_.size() && std::fabs(pulse_[bin]) > format.threshold; ++bin) {
+            if(format.storage == Storage::SPARSE) {
+                values_.push_back(pulse_[bin]);
+            } else if(format.storage == Storage::SPARSE_FLOAT) {
+                values_float_.push_back(static_cast<float>(pulse_[bin]));
+            } else {
+                // Saturate bins exceeding the range of the integer counts instead of overflowing:
+                auto counts = std::clamp(std::round(pulse_[bin] / format.quantum),
+                                         static_cast<double>(std::numeric_limits<int>::min()),
+                                         static_cast<double>(std::numeric_limits<int>::max()));
+                values_quantized_.push_back(static_cast<int>(counts));
+            }
+        }
+        runs_.push_back(static_cast<unsigned int>(start - previous_end));
+        runs_.push_back(static_cast<unsigned int>(bin - start));
+        previous_end = bin;
+    }
+    quantum_ = (format.storage == Storage::SPARSE_QUANTIZED ? format.quantum : 0.);
+    storage_ = format.storage;
+
+    // Keep the exact pulse available in memory, only the stored representation is compressed:
+    decoded_ = std::move(pulse_);
+    pulse_.clear();
+}
+
+void Pulse::expand() {
+    if(storage_ == Storage::DENSE) {
+        return;
+    }
+
+    // Pulses compressed in memory still hold their exact bins, pulses read from file only the compressed representation:
+    if(decoded_.size() != bins_) {
+        decode();
+    }
+    pulse_ = std::move(decoded_);
+    decoded_.clear();
+    storage_ = Storage::DENSE;
+    bins_ = 0;
+    runs_.clear();
+    values_.clear();
+    values_float_.clear();
+    values_quantized_.clear();
+    quantum_ = 0.;
+}
+
+void Pulse::decode() {
+    decoded_.assign(bins_, 0.);
+    size_t bin = 0;
+    size_t value = 0;
+    for(size_t run = 0; run + 1 < runs_.size(); run += 2) {
+        bin += runs_[run];
+        for(auto end = bin + runs_[run + 1]; bin < end && bin < decoded_.size(); ++bin, ++value) {
+            if(storage_ == Storage::SPARSE) {
+                decoded_[bin] = values_.at(value);
+            } else if(storage_ == Storage::SPARSE_FLOAT) {
+                decoded_[bin] = static_cast<double>(values_float_.at(value));
+            } else {
+                decoded_[bin] = quantum_ * values_quantized_.at(value);
+            }
+        }
+    }
+}
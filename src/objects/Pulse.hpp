@@ -10,6 +10,7 @@
 #ifndef ALLPIX_PULSE_H
 #define ALLPIX_PULSE_H
 
+#include <cstdint>
 #include <vector>
 
 #include <TObject.h>
@@ -19,9 +20,33 @@ namespace allpix {
      * @ingroup Objects
      * @brief Pulse holding induced charges as a function of time
      * @warning This object is special and is not meant to be written directly to a tree (not inheriting from \ref Object)
+     *
+     * Pulses are kept as dense vector of bins in memory. For storage, they can be compressed to a sparse layout which only
+     * keeps runs of non-zero bins, optionally with reduced precision of the bin values. Compressed pulses read from file
+     * have to be expanded with \ref expand before accessing the pulse shape, which is done when loading the history of the
+     * objects holding them.
      */
     class Pulse {
     public:
+        /**
+         * @brief Layout and precision of the stored pulse bins
+         */
+        enum class Storage : int8_t {
+            DENSE = 0,        ///< All bins with double precision
+            SPARSE,           ///< Runs of non-zero bins with double precision
+            SPARSE_FLOAT,     ///< Runs of non-zero bins with single precision
+            SPARSE_QUANTIZED, ///< Runs of non-zero bins as integer multiples of a charge quantum
+        };
+
+        /**
+         * @brief Format to compress pulses with for storage
+         */
+        struct StorageFormat {
+            Storage storage{Storage::DENSE}; ///< Layout and precision of the bins
+            double threshold{};              ///< Bins with an absolute charge not above this threshold are dropped
+            double quantum{};                ///< Charge of one count for quantized bins, has to be positive
+        };
+
         /**
          * @brief Construct a new pulse
          */
@@ -39,6 +64,16 @@ namespace allpix {
          */
         void addCharge(double charge, double time);
 
+        /**
+         * @brief adding charge induced during a time interval to the pulse
+         * @param charge     induced charge
+         * @param start_time start of the time interval during which the charge has been induced
+         * @param end_time   end of the time interval during which the charge has been induced
+         *
+         * The charge is distributed over all bins covered by the time interval, proportionally to their overlap with it.
+         */
+        void addCharge(double charge, double start_time, double end_time);
+
         /**
          * @brief Function to retrieve the integral (net) charge from the full pulse
          * @return Integrated charge
@@ -69,15 +104,46 @@ namespace allpix {
          */
         Pulse& operator+=(const Pulse& rhs);
 
+        /**
+         * @brief Compress the stored representation of the pulse
+         * @param format Format to compress the pulse with
+         *
+         * The pulse shape returned by \ref getPulse is not affected by the compression until the pulse is written to and
+         * read back from file. Adding charge to a compressed pulse restores the dense layout. Quantized bins saturate at the
+         * range of the integer counts.
+         */
+        void compress(const StorageFormat& format);
+
+        /**
+         * @brief Restore the dense layout of a compressed pulse, decoding the stored bins if it has been read from file
+         */
+        void expand();
+
         /**
          * @brief Default constructor for ROOT I/O
          */
-        ClassDef(Pulse, 2); // NOLINT
+        ClassDef(Pulse, 3); // NOLINT
 
     private:
+        /**
+         * @brief Decode the dense pulse shape from the stored runs of a compressed pulse
+         */
+        void decode();
+
         std::vector<double> pulse_;
         double bin_{};
         bool initialized_{};
+
+        // Compressed representation: runs are stored as pairs of the number of skipped bins and the number of bins in the run
+        Storage storage_{Storage::DENSE};
+        unsigned int bins_{};
+        std::vector<unsigned int> runs_;
+        std::vector<double> values_;
+        std::vector<float> values_float_;
+        std::vector<int> values_quantized_;
+        double quantum_{};
+
+        std::vector<double> decoded_; //! transient value
     };
 
 } // namespace allpix
@@ -7,6 +7,7 @@
  * Intergovernmental Organization or submit itself to any jurisdiction.
  */
 
+#include "CarrierTrajectory.hpp"
 #include "DepositedCharge.hpp"
 #include "MCParticle.hpp"
 #include "MCTrack.hpp"
@@ -19,5 +20,6 @@ namespace allpix {
     /**
      * @brief Tuple containing all objects
      */
-    using OBJECTS = std::tuple<MCTrack, MCParticle, DepositedCharge, PropagatedCharge, PixelCharge, PixelHit>;
+    using OBJECTS =
+        std::tuple<MCTrack, MCParticle, DepositedCharge, PropagatedCharge, CarrierTrajectory, PixelCharge, PixelHit>;
 } // namespace allpix
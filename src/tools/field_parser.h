@@ -11,10 +11,26 @@
 #define ALLPIX_FIELD_PARSER_H
 
 #include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "core/utils/log.h"
 #include "core/utils/unit.h"
@@ -27,8 +43,9 @@
 #include <cereal/types/vector.hpp>
 #include <utility>
 
-// Mime type version for APF files
+// Mime type version for APF files, version 2 is only used for data stored in single precision
 #define APF_MIME_TYPE_VERSION 1
+#define APF_MIME_TYPE_VERSION_PRECISION 2
 
 namespace allpix {
 
@@ -119,18 +136,49 @@ namespace allpix {
 
         friend class cereal::access;
 
-        // Versioned serialization function:
-        template <class Archive> void serialize(Archive& archive, std::uint32_t const version) {
-            // For now, we only know one version of this file type:
-            if(version != 1) {
+        // Versioned serialization functions, version 2 adds the floating-point precision of the stored data:
+        template <class Archive> void save(Archive& archive, std::uint32_t const version) const {
+            archive(header_);
+            if(version >= 2) {
+                archive(static_cast<std::uint8_t>(sizeof(T)));
+            }
+            archive(dimensions_);
+            archive(size_);
+            archive(data_);
+        }
+        template <class Archive> void load(Archive& archive, std::uint32_t const version) {
+            if(version != 1 && version != 2) {
                 throw std::runtime_error("unknown format version " + std::to_string(version));
             }
 
-            // (De-) Serialize the data:
             archive(header_);
+            // Version 1 does not store the precision, the data always has the type it has been written with
+            std::uint8_t precision = sizeof(T);
+            if(version >= 2) {
+                archive(precision);
+            }
             archive(dimensions_);
-            archive(size_);
-            archive(data_);
+
+            // Convert the data if it has been stored with a different precision:
+            if(precision == sizeof(T)) {
+                archive(size_);
+                archive(data_);
+            } else if(precision == sizeof(float)) {
+                load_converted<float>(archive);
+            } else if(precision == sizeof(double)) {
+                load_converted<double>(archive);
+            } else {
+                throw std::runtime_error("unknown data precision of " + std::to_string(precision) + " bytes");
+            }
+        }
+        template <typename S, class Archive> void load_converted(Archive& archive) {
+            std::array<S, 3> size{};
+            std::shared_ptr<std::vector<S>> data;
+            archive(size);
+            archive(data);
+
+            std::transform(size.begin(), size.end(), size_.begin(), [](S value) { return static_cast<T>(value); });
+            data_ = std::make_shared<std::vector<T>>(data->begin(), data->end());
         }
     };
 } // namespace allpix
@@ -138,11 +186,13 @@ namespace allpix {
 // Enable versioning for the FieldData class template
 namespace cereal {
     namespace detail {
+        // Double-precision data is written in version 1 to remain readable by earlier versions of the framework
         template <class T> struct Version<allpix::FieldData<T>> {
             static const std::uint32_t version;
             static std::uint32_t registerVersion() {
                 ::cereal::detail::StaticObject<Versions>::getInstance().mapping.emplace(
-                    std::type_index(typeid(allpix::FieldData<T>)).hash_code(), APF_MIME_TYPE_VERSION);
+                    std::type_index(typeid(allpix::FieldData<T>)).hash_code(),
+                    std::is_same<T, double>::value ? APF_MIME_TYPE_VERSION : APF_MIME_TYPE_VERSION_PRECISION);
                 return 3;
             }
             static void unused() { (void)version; } // NOLINT
@@ -154,12 +204,90 @@ namespace cereal {
 
 namespace allpix {
 
+    /**
+     * @brief Read-only memory mapping of a file
+     *
+     * The file is mapped into memory on construction and unmapped on destruction. The content can be accessed as a range
+     * of characters which is not null-terminated.
+     */
+    class MappedFile {
+    public:
+        /**
+         * @brief Map a file into memory
+         * @param path Path of the file to be mapped
+         * @throws std::runtime_error If the file cannot be opened or mapped
+         */
+        explicit MappedFile(const std::string& path) {
+            fd_ = ::open(path.c_str(), O_RDONLY);
+            if(fd_ < 0) {
+                throw std::runtime_error("could not open file");
+            }
+
+            struct stat file_stat {};
+            if(::fstat(fd_, &file_stat) != 0) {
+                ::close(fd_);
+                throw std::runtime_error("could not read file status");
+            }
+            size_ = static_cast<size_t>(file_stat.st_size);
+
+            // Mapping empty files fails, we simply provide an empty range in this case
+            if(size_ > 0) {
+                data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+                if(data_ == MAP_FAILED) { // NOLINT
+                    data_ = nullptr;
+                    ::close(fd_);
+                    throw std::runtime_error("could not map file into memory");
+                }
+                // The file is read front to back, allow the kernel to read ahead aggressively
+                ::madvise(data_, size_, MADV_SEQUENTIAL);
+            }
+        }
+        ~MappedFile() {
+            if(data_ != nullptr) {
+                ::munmap(data_, size_);
+            }
+            ::close(fd_);
+        }
+
+        /// @{
+        /**
+         * @brief Copying or moving a mapped file is not allowed
+         */
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+        /// @}
+
+        /**
+         * @brief Get the beginning of the mapped file content
+         * @return Pointer to the first character of the file
+         */
+        const char* begin() const { return static_cast<const char*>(data_); }
+
+        /**
+         * @brief Get the end of the mapped file content
+         * @return Pointer past the last character of the file
+         */
+        const char* end() const { return begin() + size_; }
+
+    private:
+        int fd_{-1};
+        void* data_{nullptr};
+        size_t size_{};
+    };
+
     /**
      * @brief Class to parse Allpix Squared field data from files
      *
      * This class can be used to deserialize and parse FieldData objects from files of different format. The FieldData
      * objects read from file are cached, and a cache hit will be returned when trying to re-read a file with the same
      * canonical path.
+     *
+     * Parsing INIT files is comparatively slow. Therefore, if a cache directory is provided, the parsed field data is
+     * additionally stored in a binary sidecar file in this directory, which is read instead of the INIT file by subsequent
+     * invocations as long as the INIT file has not changed. The sidecar is identified by the canonical path, size,
+     * modification time and content hash of the INIT file as well as the requested units.
      */
     template <typename T = double> class FieldParser {
     public:
@@ -178,11 +306,15 @@ namespace allpix {
          * @brief Parse a file and retrieve the field data.
          * @param file_name  File name (as canonical path) of the input file to be parsed
          * @param units      Optional units to convert the field from after reading from file. Only used by some formats.
+         * @param cache_directory Optional directory to store binary sidecar files of parsed INIT files in, no sidecar files
+         *                        are used if empty
          * @return           Field data object read from file or internal cache
          *
          * The type of the field data file to be read is deducted automatically from the file content
          */
-        FieldData<T> getByFileName(const std::string& file_name, const std::string& units = std::string()) {
+        FieldData<T> getByFileName(const std::string& file_name,
+                                   const std::string& units = std::string(),
+                                   const std::string& cache_directory = std::string()) {
             // Search in cache (NOTE: the path reached here is always a canonical name)
             auto iter = field_map_.find(file_name);
             if(iter != field_map_.end()) {
@@ -200,7 +332,7 @@ namespace allpix {
                     LOG(WARNING) << "No field units provided, interpreting field data in internal units, this might lead to "
                                     "unexpected results.";
                 }
-                return parse_init_file(file_name, units);
+                return read_init_file(file_name, units, cache_directory);
             case FileType::APF:
                 if(!units.empty()) {
                     LOG(DEBUG) << "Units will be ignored, APF file content is interpreted in internal units.";
@@ -291,60 +423,312 @@ namespace allpix {
             }
         }
 
+        /**
+         * @brief Calculate the 64-bit FNV-1a hash of a character range
+         * @param begin Beginning of the range
+         * @param end   End of the range
+         * @param hash  Hash to continue from, the FNV offset basis by default
+         * @return Hash of the range
+         */
+        static std::uint64_t fnv1a(const char* begin, const char* end, std::uint64_t hash = 14695981039346656037ull) {
+            for(const auto* it = begin; it != end; ++it) {
+                hash ^= static_cast<unsigned char>(*it);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        /**
+         * @brief Key identifying the INIT file and units a sidecar file has been generated from
+         */
+        struct SidecarKey {
+            std::string path;
+            uintmax_t size{};
+            std::filesystem::file_time_type::rep modification_time{};
+            std::uint64_t content_hash{};
+            std::string units;
+            size_t quantity{};
+
+            /**
+             * @brief Check whether the file status and units match, ignoring the content hash
+             * @param other Key to compare with
+             * @return True if all members but the content hash are equal
+             */
+            bool matchesStatus(const SidecarKey& other) const {
+                return path == other.path && size == other.size && modification_time == other.modification_time &&
+                       units == other.units && quantity == other.quantity;
+            }
+
+            /**
+             * @brief Get a hash of the path, size and modification time of the INIT file which is stable across platforms
+             * @return FNV-1a hash of the file identification
+             */
+            std::uint64_t getFileHash() const {
+                auto identifier = path + "\n" + std::to_string(size) + "\n" + std::to_string(modification_time);
+                return fnv1a(identifier.data(), identifier.data() + identifier.size());
+            }
+
+            template <class Archive> void serialize(Archive& archive) {
+                archive(path, size, modification_time, content_hash, units, quantity);
+            }
+        };
+
+        /**
+         * @brief Function to read FieldData from INIT files, using the binary sidecar file if it matches the INIT file
+         * @param file_name  File name (as canonical path) of the input file to be parsed
+         * @param units      Units to convert the values of the field data from
+         * @param cache_directory Directory of the sidecar files, sidecar files are not used if empty
+         *
+         * If no matching sidecar file is found, the INIT file is parsed and a new sidecar file is written. Failures to read
+         * or write the sidecar file are not fatal, the INIT file is parsed instead. The content of the INIT file is hashed
+         * and compared with the sidecar only if its file status matches, which is considerably faster than parsing it.
+         */
+        FieldData<T>
+        read_init_file(const std::string& file_name, const std::string& units, const std::string& cache_directory) {
+            FieldData<T> field_data;
+            MappedFile file(file_name);
+            if(cache_directory.empty()) {
+                field_data = parse_init_file(file, file_name, units);
+            } else {
+                // The path is canonicalized to identify the INIT file independent of how it has been referred to
+                SidecarKey key;
+                key.path = std::filesystem::weakly_canonical(file_name).string();
+                key.size = std::filesystem::file_size(file_name);
+                key.modification_time = std::filesystem::last_write_time(file_name).time_since_epoch().count();
+                key.units = units;
+                key.quantity = N_;
+
+                // Sidecar files of different INIT files with the same name are distinguished by a hash of their path, size and
+                // modification time
+                std::stringstream sidecar_name;
+                sidecar_name << std::filesystem::path(file_name).stem().string() << "-" << std::hex << std::setw(16)
+                             << std::setfill('0') << key.getFileHash() << ".apfcache";
+                auto sidecar_path = (std::filesystem::path(cache_directory) / sidecar_name.str()).string();
+
+                if(read_sidecar_file(sidecar_path, key, file, field_data)) {
+                    LOG(INFO) << "Using field data from sidecar file " << sidecar_path;
+                } else {
+                    field_data = parse_init_file(file, file_name, units);
+                    key.content_hash = fnv1a(file.begin(), file.end());
+                    write_sidecar_file(sidecar_path, key, field_data);
+                }
+            }
+
+            // Store the parsed field data for further reference:
+            field_map_[file_name] = field_data;
+            return field_data;
+        }
+
+        /**
+         * @brief Read field data from a sidecar file if its key matches the INIT file
+         * @param sidecar_name File name of the sidecar file
+         * @param key          Key expected for the sidecar file, without content hash
+         * @param file         Memory-mapped content of the INIT file to compare the content hash with
+         * @param field_data   Field data object to deserialize into
+         * @return True if the sidecar file exists, matches the key and the content of the INIT file and contains valid data,
+         * false otherwise
+         */
+        bool read_sidecar_file(const std::string& sidecar_name,
+                               const SidecarKey& key,
+                               const MappedFile& file,
+                               FieldData<T>& field_data) const {
+            std::ifstream sidecar(sidecar_name, std::ios::binary);
+            if(!sidecar.good()) {
+                return false;
+            }
+
+            try {
+                cereal::PortableBinaryInputArchive archive(sidecar);
+                SidecarKey file_key;
+                archive(file_key);
+                if(!file_key.matchesStatus(key) || file_key.content_hash != fnv1a(file.begin(), file.end())) {
+                    LOG(DEBUG) << "Sidecar file " << sidecar_name << " does not match field file, ignoring it";
+                    return false;
+                }
+                archive(field_data);
+            } catch(cereal::Exception& e) {
+                LOG(DEBUG) << "Could not read sidecar file " << sidecar_name << ": " << e.what();
+                return false;
+            } catch(std::runtime_error& e) {
+                LOG(DEBUG) << "Could not read sidecar file " << sidecar_name << ": " << e.what();
+                return false;
+            }
+
+            auto dimensions = field_data.getDimensions();
+            return field_data.getData() != nullptr &&
+                   field_data.getData()->size() == dimensions[0] * dimensions[1] * dimensions[2] * N_;
+        }
+
+        /**
+         * @brief Write field data to a sidecar file, preceded by the key of the INIT file it originates from
+         * @param sidecar_name File name of the sidecar file
+         * @param key          Key of the INIT file the field data has been parsed from
+         * @param field_data   Field data object to store
+         *
+         * The sidecar is written to a temporary file first and moved in place afterwards, such that concurrent jobs never
+         * read incomplete sidecar files.
+         */
+        void
+        write_sidecar_file(const std::string& sidecar_name, const SidecarKey& key, const FieldData<T>& field_data) const {
+            auto temporary_name = sidecar_name + "." + std::to_string(::getpid()) + ".tmp";
+            try {
+                std::filesystem::create_directories(std::filesystem::path(sidecar_name).parent_path());
+                {
+                    std::ofstream file(temporary_name, std::ios::binary);
+                    if(!file.good()) {
+                        throw std::runtime_error("could not open file for writing");
+                    }
+                    cereal::PortableBinaryOutputArchive archive(file);
+                    archive(key);
+                    archive(field_data);
+                }
+                std::filesystem::rename(temporary_name, sidecar_name);
+                LOG(DEBUG) << "Stored field data in sidecar file " << sidecar_name;
+            } catch(std::exception& e) {
+                LOG(DEBUG) << "Could not write sidecar file " << sidecar_name << ": " << e.what();
+                std::error_code ec;
+                std::filesystem::remove(temporary_name, ec);
+            }
+        }
+
+        /**
+         * @brief Skip whitespace in a character range
+         * @param it  Current position in the range
+         * @param end End of the range
+         * @return Position of the next non-whitespace character or the end of the range
+         */
+        static const char* skip_whitespace(const char* it, const char* end) {
+            while(it != end && std::isspace(static_cast<unsigned char>(*it)) != 0) {
+                ++it;
+            }
+            return it;
+        }
+
+        /**
+         * @brief Read a whitespace-delimited token from a character range
+         * @param it    Current position in the range, advanced past the token
+         * @param end   End of the range
+         * @return The token read
+         */
+        static std::string read_token(const char*& it, const char* end) {
+            it = skip_whitespace(it, end);
+            const auto* begin = it;
+            while(it != end && std::isspace(static_cast<unsigned char>(*it)) == 0) {
+                ++it;
+            }
+            return std::string(begin, it);
+        }
+
+        /**
+         * @brief Read a number from a character range without allocating or copying
+         * @param it    Current position in the range, advanced past the number
+         * @param end   End of the range
+         * @param value Number read from the range
+         * @throws std::runtime_error If no valid number could be read
+         */
+        template <typename V> static void read_number(const char*& it, const char* end, V& value) {
+            it = skip_whitespace(it, end);
+            if(it != end && *it == '+') {
+                ++it;
+            }
+            if(it == end) {
+                throw std::runtime_error("unexpected end of file");
+            }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            auto result = std::from_chars(it, end, value);
+            if(result.ec != std::errc()) {
+                throw std::runtime_error("invalid data");
+            }
+            it = result.ptr;
+#else
+            // Floating-point std::from_chars is not available, fall back to converting a copy of the token
+            auto token = read_token(it, end);
+            char* token_end = nullptr;
+            if constexpr(std::is_floating_point_v<V>) {
+                value = static_cast<V>(std::strtod(token.c_str(), &token_end));
+            } else {
+                value = static_cast<V>(std::strtoull(token.c_str(), &token_end, 10));
+            }
+            if(token_end != token.c_str() + token.size()) {
+                throw std::runtime_error("invalid data");
+            }
+#endif
+        }
+
         /**
          * @brief Function to read FieldData from INIT-formatted ASCII files. Values are interpreted in the units provided by
          * the argument and converted to the framework-internal base units. The size of the field given in the file is always
          * interpreted as micrometers.
+         * @param file       Memory-mapped content of the input file to be parsed
          * @param file_name  File name (as canonical path) of the input file to be parsed
          * @param units      Units to convert the values of the field data from
          */
-        FieldData<T> parse_init_file(const std::string& file_name, const std::string& units) {
-            // Load file
-            std::ifstream file(file_name);
-            std::string header;
-            std::getline(file, header);
+        FieldData<T> parse_init_file(const MappedFile& file, const std::string& file_name, const std::string& units) {
+            const auto* it = file.begin();
+            const auto* end = file.end();
+
+            // Read the header line
+            const auto* line_end = std::find(it, end, '\n');
+            std::string header(it, line_end);
+            if(!header.empty() && header.back() == '\r') {
+                header.pop_back();
+            }
+            it = line_end;
             LOG(TRACE) << "Header of file " << file_name << " is " << std::endl << header;
 
             // Read the header
-            std::string tmp;
             // WARNING the usage of this field as storage for the field units differs from the original INIT format!
-            file >> tmp;
-            check_unit_match(allpix::trim(tmp), units);
-            file >> tmp;               // ignore cluster length
-            file >> tmp >> tmp >> tmp; // ignore the incident pion direction
-            file >> tmp >> tmp >> tmp; // ignore the magnetic field (specify separately)
+            check_unit_match(allpix::trim(read_token(it, end)), units);
+            read_token(it, end); // ignore cluster length
+            for(size_t i = 0; i < 3; ++i) {
+                read_token(it, end); // ignore the incident pion direction
+            }
+            for(size_t i = 0; i < 3; ++i) {
+                read_token(it, end); // ignore the magnetic field (specify separately)
+            }
             double thickness = NAN, xpixsz = NAN, ypixsz = NAN;
-            file >> thickness >> xpixsz >> ypixsz;
+            size_t xsize = 0, ysize = 0, zsize = 0;
+            try {
+                read_number(it, end, thickness);
+                read_number(it, end, xpixsz);
+                read_number(it, end, ypixsz);
+                for(size_t i = 0; i < 4; ++i) {
+                    read_token(it, end); // ignore temperature, flux, rhe (?) and new_drde (?)
+                }
+                read_number(it, end, xsize);
+                read_number(it, end, ysize);
+                read_number(it, end, zsize);
+            } catch(std::runtime_error&) {
+                throw std::runtime_error("invalid data or unexpected end of file");
+            }
+            if(read_token(it, end).empty()) {
+                throw std::runtime_error("invalid data or unexpected end of file");
+            }
             thickness = Units::get(thickness, "um");
             xpixsz = Units::get(xpixsz, "um");
             ypixsz = Units::get(ypixsz, "um");
-            file >> tmp >> tmp >> tmp >> tmp; // ignore temperature, flux, rhe (?) and new_drde (?)
-            size_t xsize = 0, ysize = 0, zsize = 0;
-            file >> xsize >> ysize >> zsize;
-            file >> tmp;
 
-            if(file.fail()) {
-                throw std::runtime_error("invalid data or unexpected end of file");
-            }
             auto field = std::make_shared<std::vector<double>>();
             auto vertices = xsize * ysize * zsize;
             field->resize(vertices * N_);
 
+            // Obtain the unit conversion factor once instead of for every value. The conversion is carried out with the
+            // precision of the unit type, exactly as Units::get does for a single value:
+            auto unit_factor = Units::get(units);
+
             // Loop through all the field data
             for(size_t i = 0; i < vertices; ++i) {
                 if(vertices >= 100 && i % (vertices / 100) == 0) {
                     LOG_PROGRESS(INFO, "read_init") << "Reading field data: " << (100 * i / vertices) << "%";
                 }
 
-                if(file.eof()) {
-                    throw std::runtime_error("unexpected end of file");
-                }
-
                 // Get index of field
                 size_t xind = 0, yind = 0, zind = 0;
-                file >> xind >> yind >> zind;
+                read_number(it, end, xind);
+                read_number(it, end, yind);
+                read_number(it, end, zind);
 
-                if(file.fail() || xind > xsize || yind > ysize || zind > zsize) {
+                if(xind == 0 || yind == 0 || zind == 0 || xind > xsize || yind > ysize || zind > zsize) {
                     throw std::runtime_error("invalid data");
                 }
                 xind--;
@@ -352,22 +736,23 @@ namespace allpix {
                 zind--;
 
                 // Loop through components of field
+                auto* target = field->data() + xind * ysize * zsize * N_ + yind * zsize * N_ + zind * N_;
                 for(size_t j = 0; j < N_; ++j) {
                     double input = NAN;
-                    file >> input;
+                    read_number(it, end, input);
 
                     // Set the field at a position
-                    (*field)[xind * ysize * zsize * N_ + yind * zsize * N_ + zind * N_ + j] = Units::get(input, units);
+                    auto value = static_cast<Units::UnitType>(input) * unit_factor;
+                    if(value > std::numeric_limits<double>::max() || value < std::numeric_limits<double>::lowest()) {
+                        throw std::overflow_error("unit conversion overflows the type");
+                    }
+                    target[j] = static_cast<double>(value);
                 }
             }
             LOG_PROGRESS(INFO, "read_init") << "Reading field data: finished.";
 
-            FieldData<T> field_data(
+            return FieldData<T>(
                 header, std::array<size_t, 3>{{xsize, ysize, zsize}}, std::array<T, 3>{{xpixsz, ypixsz, thickness}}, field);
-
-            // Store the parsed field data for further reference:
-            field_map_[file_name] = field_data;
-            return field_data;
         }
 
         size_t N_;
@@ -0,0 +1,273 @@
+/**
+ * @file
+ * @brief Utility to reduce the storage size of field data by exploiting invariances and symmetries of the field
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_FIELD_REDUCTION_H
+#define ALLPIX_FIELD_REDUCTION_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "field_parser.h"
+
+namespace allpix {
+
+    /**
+     * @brief Determine along which of the in-plane axes a field does not change within a given tolerance
+     * @param field_data Field data to be analyzed
+     * @param quantity   Quantity of individual field points, vector or scalar
+     * @param tolerance  Maximum deviation allowed, given relative to the largest absolute value found in the field
+     * @return Array indicating for the x and y axis whether the field is invariant along the respective direction
+     *
+     * Axes which only have a single bin are never reported as invariant since they cannot be reduced any further.
+     */
+    template <typename T>
+    std::array<bool, 2>
+    find_invariant_axes(const FieldData<T>& field_data, const FieldQuantity quantity, const T tolerance) {
+        auto N = static_cast<std::underlying_type<FieldQuantity>::type>(quantity);
+        auto dimensions = field_data.getDimensions();
+        const auto& data = *field_data.getData();
+
+        // Compare against the largest absolute value of the field to obtain the absolute tolerance:
+        T max_value = 0;
+        for(const auto& value : data) {
+            max_value = std::max(max_value, std::fabs(value));
+        }
+        const T threshold = tolerance * max_value;
+
+        std::array<bool, 2> invariant{{dimensions[0] > 1, dimensions[1] > 1}};
+        auto stride_x = dimensions[1] * dimensions[2] * N;
+        auto stride_y = dimensions[2] * N;
+        for(size_t x = 0; x < dimensions[0] && (invariant[0] || invariant[1]); ++x) {
+            for(size_t y = 0; y < dimensions[1] && (invariant[0] || invariant[1]); ++y) {
+                for(size_t i = 0; i < stride_y; ++i) {
+                    auto value = data[x * stride_x + y * stride_y + i];
+                    // Compare to the first bin along x at the same y position and vice versa:
+                    if(invariant[0] && std::fabs(value - data[y * stride_y + i]) > threshold) {
+                        invariant[0] = false;
+                    }
+                    if(invariant[1] && std::fabs(value - data[x * stride_x + i]) > threshold) {
+                        invariant[1] = false;
+                    }
+                }
+            }
+        }
+
+        return invariant;
+    }
+
+    /**
+     * @brief Collapse field data along the requested in-plane axes to a single bin
+     * @param field_data Field data to be reduced
+     * @param quantity   Quantity of individual field points, vector or scalar
+     * @param axes       Array indicating for the x and y axis whether the field should be collapsed along this direction
+     * @return Reduced field data, retaining the header and the physical extent of the original field
+     *
+     * The value of the remaining bin is calculated as the average over all bins along the collapsed axis.
+     */
+    template <typename T>
+    FieldData<T> collapse_axes(const FieldData<T>& field_data, const FieldQuantity quantity, std::array<bool, 2> axes) {
+        auto N = static_cast<std::underlying_type<FieldQuantity>::type>(quantity);
+        auto dimensions = field_data.getDimensions();
+        const auto& data = *field_data.getData();
+
+        std::array<size_t, 3> reduced_dimensions{{axes[0] ? 1 : dimensions[0], axes[1] ? 1 : dimensions[1], dimensions[2]}};
+        auto reduced = std::make_shared<std::vector<T>>(reduced_dimensions[0] * reduced_dimensions[1] * dimensions[2] * N);
+
+        for(size_t x = 0; x < dimensions[0]; ++x) {
+            for(size_t y = 0; y < dimensions[1]; ++y) {
+                auto source = x * dimensions[1] * dimensions[2] * N + y * dimensions[2] * N;
+                auto target = (axes[0] ? 0 : x) * reduced_dimensions[1] * dimensions[2] * N +
+                              (axes[1] ? 0 : y) * dimensions[2] * N;
+                for(size_t i = 0; i < dimensions[2] * N; ++i) {
+                    (*reduced)[target + i] += data[source + i];
+                }
+            }
+        }
+
+        // Normalize to the number of bins merged into each remaining bin:
+        auto merged = static_cast<T>((dimensions[0] / reduced_dimensions[0]) * (dimensions[1] / reduced_dimensions[1]));
+        for(auto& value : *reduced) {
+            value /= merged;
+        }
+
+        return FieldData<T>(field_data.getHeader(), reduced_dimensions, field_data.getSize(), reduced);
+    }
+
+    /**
+     * @brief Determine about which of the in-plane axes a field is mirror-symmetric with respect to the center of the field
+     * @param field_data Field data to be analyzed
+     * @param quantity   Quantity of individual field points, vector or scalar
+     * @param tolerance  Maximum deviation allowed, given relative to the largest absolute value found in the field
+     * @return Array indicating for the x and y axis whether the field is symmetric when mirrored along this direction
+     *
+     * For vector fields, the component along the mirrored axis is expected to change its sign. Axes which only have a
+     * single bin are never reported as symmetric since they cannot be reduced any further.
+     */
+    template <typename T>
+    std::array<bool, 2>
+    find_symmetric_axes(const FieldData<T>& field_data, const FieldQuantity quantity, const T tolerance) {
+        auto N = static_cast<std::underlying_type<FieldQuantity>::type>(quantity);
+        auto dimensions = field_data.getDimensions();
+        const auto& data = *field_data.getData();
+
+        // Compare against the largest absolute value of the field to obtain the absolute tolerance:
+        T max_value = 0;
+        for(const auto& value : data) {
+            max_value = std::max(max_value, std::fabs(value));
+        }
+        const T threshold = tolerance * max_value;
+
+        std::array<bool, 2> symmetric{{dimensions[0] > 1, dimensions[1] > 1}};
+        auto stride_x = dimensions[1] * dimensions[2] * N;
+        auto stride_y = dimensions[2] * N;
+        for(size_t x = 0; x < dimensions[0] && (symmetric[0] || symmetric[1]); ++x) {
+            for(size_t y = 0; y < dimensions[1] && (symmetric[0] || symmetric[1]); ++y) {
+                for(size_t z = 0; z < dimensions[2]; ++z) {
+                    for(size_t j = 0; j < N; ++j) {
+                        auto value = data[x * stride_x + y * stride_y + z * N + j];
+                        // Vector components along the mirrored axis flip their sign:
+                        auto mirror_x = data[(dimensions[0] - 1 - x) * stride_x + y * stride_y + z * N + j];
+                        auto mirror_y = data[x * stride_x + (dimensions[1] - 1 - y) * stride_y + z * N + j];
+                        if(symmetric[0] && std::fabs(value - (N == 3 && j == 0 ? -mirror_x : mirror_x)) > threshold) {
+                            symmetric[0] = false;
+                        }
+                        if(symmetric[1] && std::fabs(value - (N == 3 && j == 1 ? -mirror_y : mirror_y)) > threshold) {
+                            symmetric[1] = false;
+                        }
+                    }
+                }
+            }
+        }
+
+        return symmetric;
+    }
+
+    /**
+     * @brief Reduce field data to the half or quadrant with positive coordinates along the requested mirror axes
+     * @param field_data Field data to be reduced
+     * @param quantity   Quantity of individual field points, vector or scalar
+     * @param axes       Array indicating for the x and y axis whether the field should be mirrored along this direction
+     * @return Reduced field data, retaining the header and the physical extent of the original field
+     *
+     * For an axis with n bins, the upper n - n/2 bins are retained, i.e. the central bin is kept for an odd number of bins.
+     * The stored values are averaged with their mirrored counterparts. The dimensions of the returned field data refer to
+     * the stored bins, the dimensions of the full grid have to be kept by the caller for the field lookup.
+     */
+    template <typename T>
+    FieldData<T> mirror_axes(const FieldData<T>& field_data, const FieldQuantity quantity, std::array<bool, 2> axes) {
+        auto N = static_cast<std::underlying_type<FieldQuantity>::type>(quantity);
+        auto dimensions = field_data.getDimensions();
+        const auto& data = *field_data.getData();
+
+        std::array<size_t, 3> reduced_dimensions{{axes[0] ? dimensions[0] - dimensions[0] / 2 : dimensions[0],
+                                                  axes[1] ? dimensions[1] - dimensions[1] / 2 : dimensions[1],
+                                                  dimensions[2]}};
+        auto reduced = std::make_shared<std::vector<T>>(reduced_dimensions[0] * reduced_dimensions[1] * dimensions[2] * N);
+        auto counts = std::vector<size_t>(reduced_dimensions[0] * reduced_dimensions[1], 0);
+
+        for(size_t x = 0; x < dimensions[0]; ++x) {
+            // Fold the lower half onto the upper half of the grid:
+            auto flip_x = axes[0] && x < dimensions[0] / 2;
+            auto rx = (axes[0] ? (flip_x ? dimensions[0] - 1 - x : x) - dimensions[0] / 2 : x);
+            for(size_t y = 0; y < dimensions[1]; ++y) {
+                auto flip_y = axes[1] && y < dimensions[1] / 2;
+                auto ry = (axes[1] ? (flip_y ? dimensions[1] - 1 - y : y) - dimensions[1] / 2 : y);
+
+                auto source = x * dimensions[1] * dimensions[2] * N + y * dimensions[2] * N;
+                auto target = rx * reduced_dimensions[1] * dimensions[2] * N + ry * dimensions[2] * N;
+                for(size_t z = 0; z < dimensions[2]; ++z) {
+                    for(size_t j = 0; j < N; ++j) {
+                        // Vector components along a mirrored axis flip their sign:
+                        auto negate = (N == 3 && ((j == 0 && flip_x) || (j == 1 && flip_y)));
+                        (*reduced)[target + z * N + j] += (negate ? -1 : 1) * data[source + z * N + j];
+                    }
+                }
+                counts[rx * reduced_dimensions[1] + ry]++;
+            }
+        }
+
+        // Normalize to the number of bins merged into each remaining bin:
+        for(size_t i = 0; i < counts.size(); ++i) {
+            for(size_t k = 0; k < dimensions[2] * N; ++k) {
+                (*reduced)[i * dimensions[2] * N + k] /= static_cast<T>(counts[i]);
+            }
+        }
+
+        return FieldData<T>(field_data.getHeader(), reduced_dimensions, field_data.getSize(), reduced);
+    }
+
+    /**
+     * @brief Compare lookups of a mirrored field at the bin centers of the full grid with the original field values
+     * @param field_data       Full field data before mirroring
+     * @param quantity         Quantity of individual field points, vector or scalar
+     * @param extent           Extent of the field along x and y as used for the lookup
+     * @param thickness_domain Domain along z in which the field is defined
+     * @param lookup           Function returning the stored field at a position (x, y, z), where x and y are given relative
+     *                         to the center of the field
+     * @return Largest deviation found, given relative to the largest absolute value found in the full field
+     *
+     * All bins of the full grid are looked up, covering all quadrants of the field. Errors in folding positions onto the
+     * stored bins or in restoring the sign of vector components along the mirrored axes show up as a deviation.
+     */
+    template <typename T, typename F>
+    T find_mirror_deviation(const FieldData<T>& field_data,
+                            const FieldQuantity quantity,
+                            std::array<double, 2> extent,
+                            std::pair<double, double> thickness_domain,
+                            F lookup) {
+        auto N = static_cast<std::underlying_type<FieldQuantity>::type>(quantity);
+        auto dimensions = field_data.getDimensions();
+        const auto& data = *field_data.getData();
+
+        T max_value = 0;
+        for(const auto& value : data) {
+            max_value = std::max(max_value, std::fabs(value));
+        }
+        if(max_value == 0) {
+            return 0;
+        }
+
+        T max_deviation = 0;
+        auto depth = thickness_domain.second - thickness_domain.first;
+        for(size_t x = 0; x < dimensions[0]; ++x) {
+            auto pos_x = (static_cast<double>(x) + 0.5) / static_cast<double>(dimensions[0]) * extent[0] - extent[0] / 2;
+            for(size_t y = 0; y < dimensions[1]; ++y) {
+                auto pos_y =
+                    (static_cast<double>(y) + 0.5) / static_cast<double>(dimensions[1]) * extent[1] - extent[1] / 2;
+                for(size_t z = 0; z < dimensions[2]; ++z) {
+                    auto pos_z = thickness_domain.first + (static_cast<double>(z) + 0.5) /
+                                                              static_cast<double>(dimensions[2]) * depth;
+                    auto value = lookup(pos_x, pos_y, pos_z);
+
+                    // Scalar lookups return a plain number, vector lookups provide their components:
+                    std::array<T, 3> components{};
+                    if constexpr(std::is_arithmetic_v<decltype(value)>) {
+                        components[0] = static_cast<T>(value);
+                    } else {
+                        components = {{static_cast<T>(value.x()), static_cast<T>(value.y()), static_cast<T>(value.z())}};
+                    }
+
+                    auto offset = x * dimensions[1] * dimensions[2] * N + y * dimensions[2] * N + z * N;
+                    for(size_t j = 0; j < N; ++j) {
+                        max_deviation = std::max(max_deviation, std::fabs(components[j] - data[offset + j]));
+                    }
+                }
+            }
+        }
+
+        return max_deviation / max_value;
+    }
+} // namespace allpix
+
+#endif /* ALLPIX_FIELD_REDUCTION_H */
@@ -0,0 +1,141 @@
+/**
+ * @file
+ * @brief Union-find clustering of pixel objects
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_PIXEL_CLUSTERING_H
+#define ALLPIX_PIXEL_CLUSTERING_H
+
+#include <array>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "objects/Pixel.hpp"
+#include "tools/pixel_map.h"
+
+namespace allpix {
+
+    /**
+     * @brief Clustering of pixel objects sharing an edge or a corner
+     *
+     * Every pixel object is looked up in a pixel map and joined with its already present neighbours using a disjoint-set
+     * forest with union by size and path halving, which makes the clustering linear in the number of objects independent of
+     * the cluster sizes. Clusters are numbered in the order of their first object in the input, objects within a cluster
+     * keep their input order. The internal buffers are kept between calls, such that an instance reused for every event
+     * does not allocate once the buffers have grown to the largest event size.
+     */
+    class PixelClustering {
+    public:
+        /**
+         * @brief Group pixel objects into clusters of adjacent pixels
+         * @param objects Objects providing the pixel via getPixel(), such as PixelHit or PixelCharge
+         * @return Number of clusters found
+         */
+        template <typename T> size_t operator()(const std::vector<T>& objects) {
+            // Reset buffers, keeping their storage
+            pixels_.clear();
+            parents_.resize(objects.size());
+            sizes_.assign(objects.size(), 1);
+            labels_.assign(objects.size(), std::numeric_limits<size_t>::max());
+
+            // Join every object with the objects on the same pixel and the already visited half of its neighbourhood:
+            static constexpr std::array<std::pair<int, int>, 4> neighbours{{{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}}};
+            pixels_.reserve(objects.size());
+            for(size_t object = 0; object < objects.size(); ++object) {
+                parents_[object] = object;
+                auto& first = pixels_[objects[object].getPixel().getIndex()];
+                if(first != 0) {
+                    unite(object, first - 1);
+                } else {
+                    first = object + 1;
+                }
+            }
+            for(size_t object = 0; object < objects.size(); ++object) {
+                auto index = objects[object].getPixel().getIndex();
+                for(const auto& [dx, dy] : neighbours) {
+                    if((dx < 0 && index.x() == 0) || (dy < 0 && index.y() == 0)) {
+                        continue;
+                    }
+                    auto neighbour = pixels_.find(Pixel::Index(index.x() + static_cast<unsigned int>(dx),
+                                                               index.y() + static_cast<unsigned int>(dy)));
+                    if(neighbour != pixels_.end()) {
+                        unite(object, neighbour->second - 1);
+                    }
+                }
+            }
+
+            // Assign consecutive cluster labels in the order of the first object of every cluster and count their sizes:
+            offsets_.assign(1, 0);
+            for(size_t object = 0; object < objects.size(); ++object) {
+                auto& label = labels_[find(object)];
+                if(label == std::numeric_limits<size_t>::max()) {
+                    label = offsets_.size() - 1;
+                    offsets_.push_back(0);
+                }
+                ++offsets_[label + 1];
+            }
+            for(size_t cluster = 1; cluster < offsets_.size(); ++cluster) {
+                offsets_[cluster] += offsets_[cluster - 1];
+            }
+
+            // Sort the objects by cluster, keeping the input order within every cluster:
+            members_.resize(objects.size());
+            sizes_.assign(offsets_.begin(), offsets_.end() - 1);
+            for(size_t object = 0; object < objects.size(); ++object) {
+                members_[sizes_[labels_[find(object)]]++] = object;
+            }
+            return offsets_.size() - 1;
+        }
+
+        /**
+         * @brief Get the objects of a cluster found in the last clustering
+         * @param cluster Index of the cluster
+         * @return Range of indices into the clustered objects
+         */
+        std::pair<std::vector<size_t>::const_iterator, std::vector<size_t>::const_iterator> getCluster(size_t cluster) const {
+            return {members_.begin() + static_cast<std::ptrdiff_t>(offsets_.at(cluster)),
+                    members_.begin() + static_cast<std::ptrdiff_t>(offsets_.at(cluster + 1))};
+        }
+
+    private:
+        size_t find(size_t object) {
+            while(parents_[object] != object) {
+                parents_[object] = parents_[parents_[object]];
+                object = parents_[object];
+            }
+            return object;
+        }
+
+        void unite(size_t lhs, size_t rhs) {
+            lhs = find(lhs);
+            rhs = find(rhs);
+            if(lhs == rhs) {
+                return;
+            }
+            if(sizes_[lhs] < sizes_[rhs]) {
+                std::swap(lhs, rhs);
+            }
+            parents_[rhs] = lhs;
+            sizes_[lhs] += sizes_[rhs];
+        }
+
+        // First object on every pixel, stored with an offset of one
+        PixelMap<size_t> pixels_;
+
+        // Disjoint-set forest and cluster label of every root
+        std::vector<size_t> parents_;
+        std::vector<size_t> sizes_;
+        std::vector<size_t> labels_;
+
+        // Objects sorted by cluster and the start of every cluster within them
+        std::vector<size_t> members_;
+        std::vector<size_t> offsets_;
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_PIXEL_CLUSTERING_H */
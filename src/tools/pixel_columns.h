@@ -0,0 +1,120 @@
+/**
+ * @file
+ * @brief Columnar storage layout of pixel objects in ROOT trees
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_PIXEL_COLUMNS_H
+#define ALLPIX_PIXEL_COLUMNS_H
+
+#include <string>
+#include <vector>
+
+#include <Rtypes.h>
+#include <TTree.h>
+
+namespace allpix {
+
+    /**
+     * @brief Per-event columns holding the primitive members of pixel objects of all detectors
+     *
+     * Every entry of the tree corresponds to one event, every column holds one value per pixel object. Rows are grouped by
+     * detector, the rows of the detector with index i are found in the range [offsets[i], offsets[i+1]). The value column
+     * holds the signal of pixel hits or the charge of pixel charges, depending on the name it is stored with.
+     */
+    struct PixelColumns {
+        std::vector<UInt_t> offsets;
+        std::vector<UShort_t> detector;
+        std::vector<UInt_t> x;
+        std::vector<UInt_t> y;
+        std::vector<Double_t> value;
+        std::vector<Double_t> local_time;
+        std::vector<Double_t> global_time;
+        std::vector<Double_t> local_x;
+        std::vector<Double_t> local_y;
+        std::vector<Double_t> local_z;
+        std::vector<Double_t> global_x;
+        std::vector<Double_t> global_y;
+        std::vector<Double_t> global_z;
+
+        /**
+         * @brief Remove all rows of the current event
+         */
+        void clear() {
+            offsets.clear();
+            detector.clear();
+            x.clear();
+            y.clear();
+            value.clear();
+            local_time.clear();
+            global_time.clear();
+            local_x.clear();
+            local_y.clear();
+            local_z.clear();
+            global_x.clear();
+            global_y.clear();
+            global_z.clear();
+        }
+
+        /**
+         * @brief Create branches for all columns in the given tree
+         * @param tree       Tree to create the branches in
+         * @param value_name Name of the value column
+         */
+        void branch(TTree* tree, const std::string& value_name) {
+            tree->Branch("offsets", &offsets);
+            tree->Branch("detector", &detector);
+            tree->Branch("x", &x);
+            tree->Branch("y", &y);
+            tree->Branch(value_name.c_str(), &value);
+            tree->Branch("local_time", &local_time);
+            tree->Branch("global_time", &global_time);
+            tree->Branch("local_x", &local_x);
+            tree->Branch("local_y", &local_y);
+            tree->Branch("local_z", &local_z);
+            tree->Branch("global_x", &global_x);
+            tree->Branch("global_y", &global_y);
+            tree->Branch("global_z", &global_z);
+        }
+
+        /**
+         * @brief Connect the columns required to reconstruct the pixel objects to the branches of the given tree
+         * @param tree       Tree to read the columns from
+         * @param value_name Name of the value column
+         * @param read_time  Whether the time columns are required to reconstruct the objects
+         *
+         * The positions are not read since they are given by the pixel index and the detector geometry, all other branches
+         * of the tree are disabled. The columns must not be moved in memory after they have been connected.
+         */
+        void read(TTree* tree, const std::string& value_name, bool read_time) {
+            tree->SetBranchStatus("*", false);
+            connect(tree, "offsets", &offsets_address_);
+            connect(tree, "x", &x_address_);
+            connect(tree, "y", &y_address_);
+            connect(tree, value_name, &value_address_);
+            if(read_time) {
+                connect(tree, "local_time", &local_time_address_);
+                connect(tree, "global_time", &global_time_address_);
+            }
+        }
+
+    private:
+        template <typename T> static void connect(TTree* tree, const std::string& name, T** address) {
+            tree->SetBranchStatus(name.c_str(), true);
+            tree->SetBranchAddress(name.c_str(), address);
+        }
+
+        // ROOT requires the address of a pointer to each column for reading
+        std::vector<UInt_t>* offsets_address_{&offsets};
+        std::vector<UInt_t>* x_address_{&x};
+        std::vector<UInt_t>* y_address_{&y};
+        std::vector<Double_t>* value_address_{&value};
+        std::vector<Double_t>* local_time_address_{&local_time};
+        std::vector<Double_t>* global_time_address_{&global_time};
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_PIXEL_COLUMNS_H */
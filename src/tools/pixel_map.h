@@ -0,0 +1,205 @@
+/**
+ * @file
+ * @brief Flat hash map for per-event aggregation of pixel data
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_PIXEL_MAP_H
+#define ALLPIX_PIXEL_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "objects/Pixel.hpp"
+
+namespace allpix {
+
+    /**
+     * @brief Pixel index packed into a single 64-bit integer
+     *
+     * The x index occupies the upper and the y index the lower 32 bits, such that ordering the keys is equivalent to
+     * ordering the pixel indices first by x and then by y.
+     */
+    using PixelKey = uint64_t;
+
+    /**
+     * @brief Pack a pixel index into a 64-bit key
+     * @param index Pixel index
+     * @return Packed key
+     */
+    inline PixelKey pack_pixel_index(const Pixel::Index& index) {
+        return (static_cast<PixelKey>(index.x()) << 32u) | static_cast<PixelKey>(index.y());
+    }
+
+    /**
+     * @brief Unpack a 64-bit key into a pixel index
+     * @param key Packed key
+     * @return Pixel index
+     */
+    inline Pixel::Index unpack_pixel_key(PixelKey key) {
+        return {static_cast<unsigned int>(key >> 32u), static_cast<unsigned int>(key & 0xFFFFFFFFu)};
+    }
+
+    /**
+     * @brief Open-addressing hash map from pixel indices to values
+     *
+     * Entries are stored contiguously in insertion order and looked up via a linear-probing table of entry positions,
+     * which avoids one allocation per pixel as done by a node-based map. Iteration follows the insertion order unless the
+     * entries are ordered by pixel index using \ref sort, which should be done before creating output to obtain the same
+     * order as with a std::map. Clearing the map keeps the allocated storage for reuse, including the storage of the values:
+     * values providing a clear() method, such as vectors, are cleared in place and pairs are cleared element-wise, while all
+     * other values are reset by assigning a default-constructed value once the entry is reused.
+     */
+    template <typename T> class PixelMap {
+    public:
+        using value_type = std::pair<Pixel::Index, T>;
+        using iterator = typename std::vector<value_type>::iterator;
+        using const_iterator = typename std::vector<value_type>::const_iterator;
+
+        /**
+         * @brief Access the value of a pixel, inserting a default-constructed value if not present
+         * @param index Pixel index
+         * @return Reference to the value of the pixel
+         */
+        T& operator[](const Pixel::Index& index) {
+            auto key = pack_pixel_index(index);
+            auto slot = find_slot(key);
+            if(table_[slot] == 0) {
+                // Grow the table to keep the load factor at most one half:
+                if(2 * (size_ + 1) > table_.size()) {
+                    rehash(2 * table_.size());
+                    slot = find_slot(key);
+                }
+                // Reuse entries left from before the last clear, their values have been reset already:
+                if(size_ < entries_.size()) {
+                    entries_[size_].first = index;
+                } else {
+                    entries_.emplace_back(index, T());
+                }
+                table_[slot] = static_cast<uint32_t>(++size_);
+            }
+            return entries_[table_[slot] - 1].second;
+        }
+
+        /**
+         * @brief Find the entry of a pixel
+         * @param index Pixel index
+         * @return Iterator to the entry or end iterator if not present
+         */
+        iterator find(const Pixel::Index& index) {
+            if(size_ == 0) {
+                return end();
+            }
+            auto slot = table_[find_slot(pack_pixel_index(index))];
+            return slot == 0 ? end() : entries_.begin() + (slot - 1);
+        }
+        const_iterator find(const Pixel::Index& index) const { return const_cast<PixelMap*>(this)->find(index); }
+
+        /**
+         * @brief Order the entries by pixel index, first by x and then by y
+         */
+        void sort() {
+            std::sort(begin(), end(), [](const value_type& lhs, const value_type& rhs) {
+                return pack_pixel_index(lhs.first) < pack_pixel_index(rhs.first);
+            });
+            rehash(table_.size());
+        }
+
+        /**
+         * @brief Reserve storage for the given number of pixels
+         * @param size Expected number of pixels
+         */
+        void reserve(size_t size) {
+            entries_.reserve(size);
+            if(2 * size > table_.size()) {
+                rehash(2 * size);
+            }
+        }
+
+        /**
+         * @brief Remove all entries while keeping the allocated storage of the map and its values
+         */
+        void clear() {
+            for(size_t entry = 0; entry < size_; ++entry) {
+                reset(entries_[entry].second);
+            }
+            size_ = 0;
+            std::fill(table_.begin(), table_.end(), 0);
+        }
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        iterator begin() { return entries_.begin(); }
+        iterator end() { return entries_.begin() + static_cast<std::ptrdiff_t>(size_); }
+        const_iterator begin() const { return entries_.begin(); }
+        const_iterator end() const { return entries_.begin() + static_cast<std::ptrdiff_t>(size_); }
+
+    private:
+        /**
+         * @brief Reset a value to its default state, keeping the storage of values which can be cleared in place
+         */
+        template <typename U> static void reset(U& value) {
+            if constexpr(has_clear<U>::value) {
+                value.clear();
+            } else {
+                value = U();
+            }
+        }
+        template <typename U, typename V> static void reset(std::pair<U, V>& value) {
+            reset(value.first);
+            reset(value.second);
+        }
+
+        /**
+         * @brief Check whether a value type provides a clear() method
+         */
+        template <typename U, typename = void> struct has_clear : std::false_type {};
+        template <typename U> struct has_clear<U, std::void_t<decltype(std::declval<U&>().clear())>> : std::true_type {};
+
+        /**
+         * @brief Find the table slot holding the given key or the first empty slot of its probe sequence
+         */
+        size_t find_slot(PixelKey key) {
+            if(table_.empty()) {
+                rehash(16);
+            }
+            auto mask = table_.size() - 1;
+            // Fibonacci hashing spreads neighbouring pixels over the table:
+            auto slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32u) & mask;
+            while(table_[slot] != 0 && pack_pixel_index(entries_[table_[slot] - 1].first) != key) {
+                slot = (slot + 1) & mask;
+            }
+            return slot;
+        }
+
+        /**
+         * @brief Rebuild the table with at least the given number of slots, rounded up to a power of two
+         */
+        void rehash(size_t size) {
+            size_t capacity = 16;
+            while(capacity < size) {
+                capacity *= 2;
+            }
+            table_.assign(capacity, 0);
+            for(size_t entry = 0; entry < size_; ++entry) {
+                table_[find_slot(pack_pixel_index(entries_[entry].first))] = static_cast<uint32_t>(entry + 1);
+            }
+        }
+
+        // Entries in insertion order and table of entry positions plus one, zero marking empty slots. Only the first size_
+        // entries are in use, the remaining ones are kept with reset values for reuse after clearing the map.
+        std::vector<value_type> entries_;
+        std::vector<uint32_t> table_;
+        size_t size_{};
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_PIXEL_MAP_H */
@@ -0,0 +1,48 @@
+/**
+ * @file
+ * @brief Convolution of a sampled pulse with an impulse response
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_PULSE_CONVOLUTION_H
+#define ALLPIX_PULSE_CONVOLUTION_H
+
+#include <stdexcept>
+#include <vector>
+
+namespace allpix {
+
+    /**
+     * @brief Convolve a pulse with an impulse response sampled at the same time step
+     * @param pulse    Input pulse
+     * @param response Impulse response, at least as long as the output
+     * @param output   Output signal, its size determines the number of time points calculated
+     *
+     * Only the terms with an input bin inside the pulse are summed, such that the output at time point k is given by the sum
+     * of pulse[k - i] * response[i] for all i from max(0, k - (pulse.size() - 1)) to k.
+     */
+    inline void convolve_pulse(const std::vector<double>& pulse,
+                               const std::vector<double>& response,
+                               std::vector<double>& output) {
+        if(response.size() < output.size()) {
+            throw std::out_of_range("impulse response shorter than requested output");
+        }
+
+        auto input_length = pulse.size();
+        for(size_t k = 0; k < output.size(); ++k) {
+            double outsum{};
+            if(input_length > 0) {
+                size_t jmin = (k >= input_length - 1) ? k - (input_length - 1) : 0;
+                for(size_t i = jmin; i <= k; ++i) {
+                    outsum += pulse[k - i] * response[i];
+                }
+            }
+            output[k] = outsum;
+        }
+    }
+} // namespace allpix
+
+#endif /* ALLPIX_PULSE_CONVOLUTION_H */
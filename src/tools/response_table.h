@@ -0,0 +1,234 @@
+/**
+ * @file
+ * @brief Utility to store and retrieve binned charge-sharing response tables
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_RESPONSE_TABLE_H
+#define ALLPIX_RESPONSE_TABLE_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cereal/archives/portable_binary.hpp>
+
+#include <cereal/types/array.hpp>
+#include <cereal/types/common.hpp>
+#include <cereal/types/map.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+
+#include "objects/SensorCharge.hpp"
+
+namespace allpix {
+
+    /**
+     * @brief Binned response of a pixel matrix to charge carriers deposited within a single pixel cell
+     *
+     * The pixel cell is divided into bins along the in-pixel coordinates and the sensor depth. For every bin and every
+     * pixel of a matrix centered around the pixel of the deposition, the table stores the fraction of the deposited charge
+     * carriers collected in this pixel as well as the mean and RMS of their arrival time relative to the deposition. In-pixel
+     * coordinates are given relative to the pixel center, the depth is measured from the lower edge of the sensor. All
+     * values are stored in framework-internal base units.
+     */
+    class ResponseTable {
+    public:
+        /**
+         * @brief Response of a single pixel to the charge carriers deposited in one bin
+         */
+        struct Response {
+            double fraction{};  ///< Fraction of the deposited charge carriers collected in the pixel
+            double time_mean{}; ///< Mean arrival time of the collected charge carriers
+            double time_rms{};  ///< RMS of the arrival time of the collected charge carriers
+
+            template <class Archive> void serialize(Archive& archive) { archive(fraction, time_mean, time_rms); }
+        };
+
+        /**
+         * @brief Default constructor, required for deserialization
+         */
+        ResponseTable() = default;
+
+        /**
+         * @brief Construct an empty response table
+         * @param bins   Number of bins along the in-pixel x and y coordinates and the sensor depth
+         * @param size   Physical extent of the table, i.e. the pixel pitch in x and y and the sensor thickness
+         * @param matrix Number of pixels of the response matrix in x and y, has to be odd
+         */
+        ResponseTable(std::array<size_t, 3> bins, std::array<double, 3> size, std::array<size_t, 2> matrix)
+            : bins_(bins), size_(size), matrix_(matrix) {}
+
+        /**
+         * @brief Get the number of bins along the in-pixel x and y coordinates and the sensor depth
+         * @return Array with the number of bins
+         */
+        std::array<size_t, 3> getBins() const { return bins_; }
+
+        /**
+         * @brief Get the physical extent of the table
+         * @return Array with pixel pitch in x and y and the sensor thickness
+         */
+        std::array<double, 3> getSize() const { return size_; }
+
+        /**
+         * @brief Get the size of the response matrix
+         * @return Array with the number of pixels in x and y
+         */
+        std::array<size_t, 2> getMatrix() const { return matrix_; }
+
+        /**
+         * @brief Get the total number of bins of the table
+         * @return Number of bins
+         */
+        size_t getNumberOfBins() const { return bins_[0] * bins_[1] * bins_[2]; }
+
+        /**
+         * @brief Get the number of pixels of the response matrix
+         * @return Number of pixels
+         */
+        size_t getMatrixSize() const { return matrix_[0] * matrix_[1]; }
+
+        /**
+         * @brief Find the bin of a position within the pixel cell, positions outside the cell are assigned to the edge bins
+         * @param x In-pixel x coordinate relative to the pixel center
+         * @param y In-pixel y coordinate relative to the pixel center
+         * @param z Depth measured from the lower edge of the sensor
+         * @return Index of the bin
+         */
+        size_t getBin(double x, double y, double z) const {
+            auto index = [](double value, double size, size_t bins) {
+                auto bin = static_cast<long>(std::floor(value / size * static_cast<double>(bins)));
+                return static_cast<size_t>(std::clamp(bin, 0L, static_cast<long>(bins) - 1));
+            };
+            return (index(x + size_[0] / 2, size_[0], bins_[0]) * bins_[1] + index(y + size_[1] / 2, size_[1], bins_[1])) *
+                       bins_[2] +
+                   index(z, size_[2], bins_[2]);
+        }
+
+        /**
+         * @brief Get the position of a pixel in the response matrix
+         * @param dx Pixel offset in x with respect to the pixel of the deposition
+         * @param dy Pixel offset in y with respect to the pixel of the deposition
+         * @return Index of the pixel within the response matrix
+         */
+        size_t getMatrixIndex(int dx, int dy) const {
+            return static_cast<size_t>(dx + static_cast<int>(matrix_[0] / 2)) * matrix_[1] +
+                   static_cast<size_t>(dy + static_cast<int>(matrix_[1] / 2));
+        }
+
+        /**
+         * @brief Check whether the given offset lies within the response matrix
+         * @param dx Pixel offset in x with respect to the pixel of the deposition
+         * @param dy Pixel offset in y with respect to the pixel of the deposition
+         * @return True if the pixel is part of the response matrix
+         */
+        bool isWithinMatrix(int dx, int dy) const {
+            return std::abs(dx) <= static_cast<int>(matrix_[0] / 2) && std::abs(dy) <= static_cast<int>(matrix_[1] / 2);
+        }
+
+        /**
+         * @brief Check whether the table holds responses for the given charge carrier type
+         * @param type Type of charge carrier
+         * @return True if responses are available
+         */
+        bool hasResponses(CarrierType type) const { return responses_.find(type) != responses_.end(); }
+
+        /**
+         * @brief Access the responses for the given charge carrier type, creating them if not available yet
+         * @param type Type of charge carrier
+         * @return Flat vector with the responses of all pixels of the matrix for every bin
+         */
+        std::vector<Response>& getResponses(CarrierType type) {
+            auto& responses = responses_[type];
+            responses.resize(getNumberOfBins() * getMatrixSize());
+            return responses;
+        }
+
+        /**
+         * @brief Access the responses for the given charge carrier type
+         * @param type Type of charge carrier
+         * @return Flat vector with the responses of all pixels of the matrix for every bin
+         * @throws std::out_of_range if no responses are available for this charge carrier type
+         */
+        const std::vector<Response>& getResponses(CarrierType type) const { return responses_.at(type); }
+
+        /**
+         * @brief Read a response table from file
+         * @param file_name Path of the file to read from
+         * @return Response table
+         * @throws std::runtime_error if the file cannot be read or contains inconsistent data
+         */
+        static ResponseTable read(const std::string& file_name) {
+            std::ifstream file(file_name, std::ios::binary);
+            if(!file.good()) {
+                throw std::runtime_error("file cannot be opened");
+            }
+
+            ResponseTable table;
+            try {
+                cereal::PortableBinaryInputArchive archive(file);
+                archive(table);
+            } catch(cereal::Exception& e) {
+                throw std::runtime_error(e.what());
+            }
+
+            if(table.getNumberOfBins() == 0 || table.matrix_[0] % 2 == 0 || table.matrix_[1] % 2 == 0) {
+                throw std::runtime_error("invalid table dimensions");
+            }
+            for(const auto& responses : table.responses_) {
+                if(responses.second.size() != table.getNumberOfBins() * table.getMatrixSize()) {
+                    throw std::runtime_error("invalid data");
+                }
+            }
+            return table;
+        }
+
+        /**
+         * @brief Write the response table to file
+         * @param file_name Path of the file to write to
+         * @throws std::runtime_error if the file cannot be written
+         */
+        void write(const std::string& file_name) const {
+            std::ofstream file(file_name, std::ios::binary);
+            if(!file.good()) {
+                throw std::runtime_error("file cannot be opened");
+            }
+
+            try {
+                cereal::PortableBinaryOutputArchive archive(file);
+                archive(*this);
+            } catch(cereal::Exception& e) {
+                throw std::runtime_error(e.what());
+            }
+
+            // Flush the stream to detect errors such as a full disk before reporting success
+            file.flush();
+            if(!file.good()) {
+                throw std::runtime_error("file cannot be written");
+            }
+        }
+
+    private:
+        std::array<size_t, 3> bins_{};
+        std::array<double, 3> size_{};
+        std::array<size_t, 2> matrix_{};
+        std::map<CarrierType, std::vector<Response>> responses_;
+
+        friend class cereal::access;
+        template <class Archive> void serialize(Archive& archive, std::uint32_t const) {
+            archive(bins_, size_, matrix_, responses_);
+        }
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_RESPONSE_TABLE_H */
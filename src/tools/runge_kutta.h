@@ -91,6 +91,11 @@ namespace allpix {
          * @return Current time
          */
         T getTime() { return t_; }
+        /**
+         * @brief Changes the time during integration
+         * @note Can be used together with \ref setValue to reject a step and repeat it with a different time step
+         */
+        void setTime(T t) { t_ = std::move(t); }
 
         /**
          * @brief Execute a single time step of the integration
@@ -0,0 +1,110 @@
+/**
+ * @file
+ * @brief Step size control for adaptive Runge-Kutta integration of charge carrier motion
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_TIMESTEP_CONTROL_H
+#define ALLPIX_TIMESTEP_CONTROL_H
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/utils/log.h"
+
+namespace allpix {
+
+    /**
+     * @brief Proportional-integral controller for the time step of an embedded fifth-order Runge-Kutta method
+     *
+     * Steps with an error estimate above the target precision are rejected and have to be repeated with a smaller time
+     * step, unless the minimum time step has been reached already. After an accepted step, the next time step is derived
+     * from the errors of the current and the previous accepted step, and is not increased directly after a rejected step.
+     * One controller should be used per integrated trajectory.
+     */
+    class PITimestepController {
+    public:
+        /**
+         * @brief Construct a time step controller
+         * @param target_precision Target error estimate of a single step
+         * @param safety_factor Factor applied to every time step change, between zero and one
+         * @param timestep_min Minimum time step, steps with this time step are always accepted
+         * @param timestep_max Maximum time step
+         */
+        PITimestepController(double target_precision, double safety_factor, double timestep_min, double timestep_max)
+            : target_precision_(target_precision), safety_factor_(safety_factor), timestep_min_(timestep_min),
+              timestep_max_(timestep_max) {}
+
+        /**
+         * @brief Check whether a step has to be repeated because it exceeds the target precision
+         * @param error Error estimate of the step
+         * @param timestep Time step of the step, replaced by the time step to repeat it with if the step is rejected
+         * @return True if the step is rejected, false if it is accepted
+         */
+        bool reject(double error, double& timestep) {
+            if(error <= target_precision_ || timestep <= timestep_min_) {
+                return false;
+            }
+
+            ++rejected_steps_;
+            last_rejected_ = true;
+
+            // Shrink the timestep according to the error of the rejected step
+            auto factor = safety_factor_ * std::pow(target_precision_ / error, 0.2);
+            timestep = std::max(timestep * std::max(factor, 0.2), timestep_min_);
+            return true;
+        }
+
+        /**
+         * @brief Calculate the time step following an accepted step
+         * @param error Error estimate of the accepted step
+         * @param timestep Time step of the accepted step
+         * @return Time step for the next step, limited to the minimum and maximum time step
+         */
+        double next(double error, double timestep) {
+            // Use the errors of the current and the previous step relative to the target precision for the fourth-order
+            // error estimate:
+            auto error_ratio = std::max(error / target_precision_, 1e-4);
+            auto factor = safety_factor_ * std::pow(error_ratio, -0.7 / 5) * std::pow(last_error_ratio_, 0.4 / 5);
+            factor = std::clamp(factor, 0.2, last_rejected_ ? 1. : 5.);
+            last_error_ratio_ = error_ratio;
+            last_rejected_ = false;
+            return std::clamp(timestep * factor, timestep_min_, timestep_max_);
+        }
+
+        /**
+         * @brief Get the number of steps rejected so far
+         * @return Number of rejected steps
+         */
+        unsigned int getRejectedSteps() const { return rejected_steps_; }
+
+    private:
+        double target_precision_;
+        double safety_factor_;
+        double timestep_min_;
+        double timestep_max_;
+
+        // Error of the previous accepted step relative to the target precision
+        double last_error_ratio_{1.};
+        bool last_rejected_{false};
+        unsigned int rejected_steps_{0};
+    };
+
+    /**
+     * @brief Log the average number of integration steps per set of charge carriers and the fraction of rejected steps
+     * @param groups Number of propagated sets of charge carriers
+     * @param integration_steps Number of integration steps including the rejected ones
+     * @param rejected_steps Number of rejected integration steps
+     */
+    inline void log_timestep_statistics(unsigned long groups, unsigned long integration_steps, unsigned long rejected_steps) {
+        auto average_steps = static_cast<double>(integration_steps) / static_cast<double>(std::max(1ul, groups));
+        auto rejected_fraction = static_cast<double>(rejected_steps) / static_cast<double>(std::max(1ul, integration_steps));
+        LOG(INFO) << "Performed " << average_steps << " integration steps per set of charge carriers on average, "
+                  << 100. * rejected_fraction << "% of the steps have been rejected";
+    }
+} // namespace allpix
+
+#endif /* ALLPIX_TIMESTEP_CONTROL_H */
@@ -0,0 +1,369 @@
+/**
+ * @file
+ * @brief Small tool to resample field data onto a different grid and to convert its precision
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/utils/log.h"
+#include "tools/field_parser.h"
+#include "tools/units.h"
+
+using namespace allpix;
+
+namespace {
+    /**
+     * @brief Axis-aligned region of a field, given by the lower and upper edge along each axis in internal units
+     */
+    using Region = std::array<std::pair<double, double>, 3>;
+
+    /**
+     * @brief Interpolate field data trilinearly between the centers of its bins
+     * @param field_data Field data to be interpolated
+     * @param N          Number of components per field point
+     * @param position   Position relative to the lower edge of the field
+     * @return Interpolated field components at the given position
+     *
+     * Positions between the outermost bin centers and the edges of the field take the value of the outermost bin.
+     */
+    std::vector<double> interpolate(const FieldData<double>& field_data, size_t N, const std::array<double, 3>& position) {
+        auto dimensions = field_data.getDimensions();
+        auto size = field_data.getSize();
+        const auto& data = *field_data.getData();
+
+        // Determine the neighboring bin centers and the interpolation weights along each axis:
+        std::array<size_t, 3> lower{}, upper{};
+        std::array<double, 3> weight{};
+        for(size_t a = 0; a < 3; ++a) {
+            auto pos = position[a] / size[a] * static_cast<double>(dimensions[a]) - 0.5;
+            pos = std::clamp(pos, 0., static_cast<double>(dimensions[a] - 1));
+            lower[a] = static_cast<size_t>(std::floor(pos));
+            upper[a] = std::min(lower[a] + 1, dimensions[a] - 1);
+            weight[a] = pos - static_cast<double>(lower[a]);
+        }
+
+        std::vector<double> value(N, 0.);
+        for(size_t corner = 0; corner < 8; ++corner) {
+            std::array<size_t, 3> index{};
+            double w = 1.;
+            for(size_t a = 0; a < 3; ++a) {
+                auto high = ((corner >> a) & 1U) != 0;
+                index[a] = (high ? upper[a] : lower[a]);
+                w *= (high ? weight[a] : 1. - weight[a]);
+            }
+            if(w == 0.) {
+                continue;
+            }
+
+            auto offset = ((index[0] * dimensions[1] + index[1]) * dimensions[2] + index[2]) * N;
+            for(size_t j = 0; j < N; ++j) {
+                value[j] += w * data[offset + j];
+            }
+        }
+        return value;
+    }
+
+    /**
+     * @brief Average field data over a box, treating the field as constant within each of its bins
+     * @param field_data Field data to be averaged
+     * @param N          Number of components per field point
+     * @param box        Box to average over, relative to the lower edge of the field
+     * @return Field components averaged over the volume of the box
+     */
+    std::vector<double> average(const FieldData<double>& field_data, size_t N, const Region& box) {
+        auto dimensions = field_data.getDimensions();
+        auto size = field_data.getSize();
+        const auto& data = *field_data.getData();
+
+        // Find the range of bins and their overlap with the box along each axis:
+        std::array<std::vector<std::pair<size_t, double>>, 3> overlaps;
+        for(size_t a = 0; a < 3; ++a) {
+            auto pitch = size[a] / static_cast<double>(dimensions[a]);
+            auto first = static_cast<size_t>(std::clamp(std::floor(box[a].first / pitch), 0., double(dimensions[a] - 1)));
+            auto last = static_cast<size_t>(std::clamp(std::ceil(box[a].second / pitch), 1., double(dimensions[a])));
+            for(size_t i = first; i < last; ++i) {
+                auto overlap = std::min(box[a].second, pitch * static_cast<double>(i + 1)) -
+                               std::max(box[a].first, pitch * static_cast<double>(i));
+                if(overlap > 0.) {
+                    overlaps[a].emplace_back(i, overlap);
+                }
+            }
+        }
+
+        std::vector<double> value(N, 0.);
+        double volume = 0.;
+        for(const auto& [x, wx] : overlaps[0]) {
+            for(const auto& [y, wy] : overlaps[1]) {
+                for(const auto& [z, wz] : overlaps[2]) {
+                    auto offset = ((x * dimensions[1] + y) * dimensions[2] + z) * N;
+                    for(size_t j = 0; j < N; ++j) {
+                        value[j] += wx * wy * wz * data[offset + j];
+                    }
+                    volume += wx * wy * wz;
+                }
+            }
+        }
+
+        if(volume > 0.) {
+            std::transform(value.begin(), value.end(), value.begin(), [volume](double v) { return v / volume; });
+        }
+        return value;
+    }
+} // namespace
+
+/**
+ * @brief Main function running the application
+ */
+int main(int argc, const char* argv[]) {
+
+    int return_code = 0;
+    try {
+
+        // Register the default set of units with this executable:
+        register_units();
+
+        // Add cout as the default logging stream
+        Log::addStream(std::cout);
+
+        // If no arguments are provided, print the help:
+        bool print_help = false;
+        if(argc == 1) {
+            print_help = true;
+            return_code = 1;
+        }
+
+        // Parse arguments
+        FileType format_to = FileType::APF;
+        std::string file_input;
+        std::string file_output;
+        std::string units;
+        std::string interpolation = "trilinear";
+        std::array<size_t, 3> bins{};
+        std::array<double, 6> crop{};
+        bool cropped = false;
+        bool scalar = false;
+        bool single_precision = false;
+        for(int i = 1; i < argc; i++) {
+            if(strcmp(argv[i], "-h") == 0) {
+                print_help = true;
+            } else if(strcmp(argv[i], "-v") == 0 && (i + 1 < argc)) {
+                try {
+                    LogLevel log_level = Log::getLevelFromString(std::string(argv[++i]));
+                    Log::setReportingLevel(log_level);
+                } catch(std::invalid_argument& e) {
+                    LOG(ERROR) << "Invalid verbosity level \"" << std::string(argv[i]) << "\", ignoring overwrite";
+                }
+            } else if(strcmp(argv[i], "--to") == 0 && (i + 1 < argc)) {
+                std::string format = std::string(argv[++i]);
+                std::transform(format.begin(), format.end(), format.begin(), ::tolower);
+                format_to = (format == "init" ? FileType::INIT : format == "apf" ? FileType::APF : FileType::UNKNOWN);
+            } else if(strcmp(argv[i], "--input") == 0 && (i + 1 < argc)) {
+                file_input = std::string(argv[++i]);
+            } else if(strcmp(argv[i], "--output") == 0 && (i + 1 < argc)) {
+                file_output = std::string(argv[++i]);
+            } else if(strcmp(argv[i], "--units") == 0 && (i + 1 < argc)) {
+                units = std::string(argv[++i]);
+            } else if(strcmp(argv[i], "--bins") == 0 && (i + 3 < argc)) {
+                for(auto& bin : bins) {
+                    bin = std::stoul(argv[++i]);
+                }
+            } else if(strcmp(argv[i], "--crop") == 0 && (i + 6 < argc)) {
+                for(auto& edge : crop) {
+                    edge = std::stod(argv[++i]);
+                }
+                cropped = true;
+            } else if(strcmp(argv[i], "--interpolation") == 0 && (i + 1 < argc)) {
+                interpolation = std::string(argv[++i]);
+                std::transform(interpolation.begin(), interpolation.end(), interpolation.begin(), ::tolower);
+            } else if(strcmp(argv[i], "--scalar") == 0) {
+                scalar = true;
+            } else if(strcmp(argv[i], "--float") == 0) {
+                single_precision = true;
+            } else {
+                LOG(ERROR) << "Unrecognized command line argument \"" << argv[i] << "\"";
+                print_help = true;
+                return_code = 1;
+            }
+        }
+
+        // Print help if requested or no arguments given
+        if(print_help) {
+            std::cout << "Allpix Squared Field Resampler Tool" << std::endl;
+            std::cout << std::endl;
+            std::cout << "Usage: field_resampler <parameters>" << std::endl;
+            std::cout << std::endl;
+            std::cout << "Parameters (all mandatory):" << std::endl;
+            std::cout << "  --input <file>            input field file" << std::endl;
+            std::cout << "  --output <file>           output field file" << std::endl << std::endl;
+            std::cout << "Options:" << std::endl;
+            std::cout << "  --units <units>           units of the field values in INIT input and output files. Default is"
+                      << std::endl;
+            std::cout << "                            internal units" << std::endl;
+            std::cout << "  --to <format>             file format of the output file. Default is APF" << std::endl;
+            std::cout << "  --bins <nx> <ny> <nz>     number of bins of the output grid. Default is the input binning"
+                      << std::endl;
+            std::cout << "  --crop <x0> <x1> <y0> <y1> <z0> <z1>" << std::endl;
+            std::cout << "                            region to retain in um, measured from the lower field edges"
+                      << std::endl;
+            std::cout << "  --interpolation <method>  trilinear or conservative. Default is trilinear" << std::endl;
+            std::cout << "  --float                   store APF output in single precision" << std::endl;
+            std::cout << "  --scalar                  Resample scalar field. Default is vector field" << std::endl;
+            std::cout << std::endl;
+            std::cout << "For more help, please see <https://cern.ch/allpix-squared>" << std::endl;
+            return return_code;
+        }
+
+        if(file_input.empty() || file_output.empty()) {
+            throw std::invalid_argument("input and output file are mandatory");
+        }
+        if(format_to == FileType::UNKNOWN) {
+            throw std::invalid_argument("unknown output file format");
+        }
+        if(interpolation != "trilinear" && interpolation != "conservative") {
+            throw std::invalid_argument("unknown interpolation method \"" + interpolation + "\"");
+        }
+        if(single_precision && format_to != FileType::APF) {
+            throw std::invalid_argument("single-precision output is only supported for the APF format");
+        }
+
+        FieldQuantity quantity = (scalar ? FieldQuantity::SCALAR : FieldQuantity::VECTOR);
+        auto N = static_cast<size_t>(quantity);
+
+        FieldParser<double> field_parser(quantity);
+        LOG(STATUS) << "Reading input file from " << file_input;
+        auto field_data = field_parser.getByFileName(file_input, units);
+        auto dimensions = field_data.getDimensions();
+        auto size = field_data.getSize();
+
+        // Determine the region to be resampled, defaulting to the full field:
+        Region region;
+        for(size_t a = 0; a < 3; ++a) {
+            region[a] = {0., size[a]};
+            if(cropped) {
+                auto um = static_cast<double>(Units::get("um"));
+                region[a] = {std::max(0., crop[2 * a] * um), std::min(size[a], crop[2 * a + 1] * um)};
+            }
+            if(region[a].second <= region[a].first) {
+                throw std::invalid_argument("empty crop region along axis " + std::to_string(a));
+            }
+            if(bins[a] == 0) {
+                // Keep the original bin pitch if no binning has been requested:
+                auto pitch = size[a] / static_cast<double>(dimensions[a]);
+                bins[a] = std::max(size_t(1), static_cast<size_t>(std::lround((region[a].second - region[a].first) / pitch)));
+            }
+        }
+
+        LOG(STATUS) << "Resampling field from " << dimensions[0] << "x" << dimensions[1] << "x" << dimensions[2] << " to "
+                    << bins[0] << "x" << bins[1] << "x" << bins[2] << " bins using " << interpolation << " interpolation";
+
+        auto resampled = std::make_shared<std::vector<double>>(bins[0] * bins[1] * bins[2] * N);
+        std::array<double, 3> pitch{};
+        for(size_t a = 0; a < 3; ++a) {
+            pitch[a] = (region[a].second - region[a].first) / static_cast<double>(bins[a]);
+        }
+        for(size_t x = 0; x < bins[0]; ++x) {
+            for(size_t y = 0; y < bins[1]; ++y) {
+                for(size_t z = 0; z < bins[2]; ++z) {
+                    std::array<size_t, 3> index{{x, y, z}};
+                    std::vector<double> value;
+                    if(interpolation == "trilinear") {
+                        std::array<double, 3> center{};
+                        for(size_t a = 0; a < 3; ++a) {
+                            center[a] = region[a].first + (static_cast<double>(index[a]) + 0.5) * pitch[a];
+                        }
+                        value = interpolate(field_data, N, center);
+                    } else {
+                        Region box;
+                        for(size_t a = 0; a < 3; ++a) {
+                            box[a] = {region[a].first + static_cast<double>(index[a]) * pitch[a],
+                                      region[a].first + static_cast<double>(index[a] + 1) * pitch[a]};
+                        }
+                        value = average(field_data, N, box);
+                    }
+
+                    // Round to the output precision so the error estimate below reflects the stored values:
+                    auto offset = ((x * bins[1] + y) * bins[2] + z) * N;
+                    for(size_t j = 0; j < N; ++j) {
+                        (*resampled)[offset + j] = (single_precision ? static_cast<float>(value[j]) : value[j]);
+                    }
+                }
+            }
+        }
+
+        std::array<double, 3> resampled_size{};
+        for(size_t a = 0; a < 3; ++a) {
+            resampled_size[a] = region[a].second - region[a].first;
+        }
+        FieldData<double> output_data(field_data.getHeader(), bins, resampled_size, resampled);
+
+        // Estimate the resampling error by evaluating the new grid at the original bin centers within the region:
+        double max_value = 0., max_deviation = 0., sum_squares = 0.;
+        size_t points = 0;
+        const auto& data = *field_data.getData();
+        for(size_t x = 0; x < dimensions[0]; ++x) {
+            for(size_t y = 0; y < dimensions[1]; ++y) {
+                for(size_t z = 0; z < dimensions[2]; ++z) {
+                    std::array<size_t, 3> index{{x, y, z}};
+                    std::array<double, 3> center{};
+                    bool inside = true;
+                    for(size_t a = 0; a < 3; ++a) {
+                        auto pos = (static_cast<double>(index[a]) + 0.5) * size[a] / static_cast<double>(dimensions[a]);
+                        inside &= (pos >= region[a].first && pos <= region[a].second);
+                        center[a] = pos - region[a].first;
+                    }
+                    if(!inside) {
+                        continue;
+                    }
+
+                    auto value = interpolate(output_data, N, center);
+                    auto offset = ((x * dimensions[1] + y) * dimensions[2] + z) * N;
+                    for(size_t j = 0; j < N; ++j) {
+                        auto deviation = std::fabs(value[j] - data[offset + j]);
+                        max_deviation = std::max(max_deviation, deviation);
+                        max_value = std::max(max_value, std::fabs(data[offset + j]));
+                        sum_squares += deviation * deviation;
+                    }
+                    points++;
+                }
+            }
+        }
+        auto rms_deviation = (points > 0 ? std::sqrt(sum_squares / static_cast<double>(points * N)) : 0.);
+        auto output_units = (units.empty() ? std::string() : " " + units);
+        LOG(STATUS) << "Resampling error at " << points << " original bin centers:" << std::endl
+                    << "  maximum deviation: "
+                    << (units.empty() ? max_deviation : static_cast<double>(Units::convert(max_deviation, units)))
+                    << output_units << " ("
+                    << (max_value > 0. ? 100. * max_deviation / max_value : 0.) << "% of maximum)" << std::endl
+                    << "  RMS deviation:     "
+                    << (units.empty() ? rms_deviation : static_cast<double>(Units::convert(rms_deviation, units)))
+                    << output_units << " (" << (max_value > 0. ? 100. * rms_deviation / max_value : 0.)
+                    << "% of maximum)";
+
+        LOG(STATUS) << "Writing output file to " << file_output;
+        if(single_precision) {
+            auto output_float = std::make_shared<std::vector<float>>(resampled->begin(), resampled->end());
+            FieldData<float> float_data(output_data.getHeader(),
+                                        bins,
+                                        {{static_cast<float>(resampled_size[0]),
+                                          static_cast<float>(resampled_size[1]),
+                                          static_cast<float>(resampled_size[2])}},
+                                        output_float);
+            FieldWriter<float> field_writer(quantity);
+            field_writer.writeFile(float_data, file_output, format_to);
+        } else {
+            FieldWriter<double> field_writer(quantity);
+            field_writer.writeFile(output_data, file_output, format_to, (format_to == FileType::INIT ? units : ""));
+        }
+    } catch(std::exception& e) {
+        LOG(FATAL) << "Fatal internal error" << std::endl << e.what() << std::endl << "Cannot continue.";
+        return_code = 127;
+    }
+
+    return return_code;
+}
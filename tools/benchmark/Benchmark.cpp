@@ -0,0 +1,472 @@
+/**
+ * @file
+ * @brief Benchmark of the core computational kernels of the framework
+ * @copyright Copyright (c) 2021 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <Math/Point3D.h>
+#include <Math/Rotation3D.h>
+#include <Math/Vector3D.h>
+
+#include "core/config/ConfigReader.hpp"
+#include "core/geometry/Detector.hpp"
+#include "core/geometry/MonolithicPixelDetectorModel.hpp"
+#include "core/module/ThreadPool.hpp"
+#include "core/utils/log.h"
+#include "objects/Pulse.hpp"
+#include "objects/SensorCharge.hpp"
+#include "physics/Mobility.hpp"
+#include "physics/Recombination.hpp"
+#include "tools/field_parser.h"
+#include "tools/pulse_convolution.h"
+#include "tools/runge_kutta.h"
+#include "tools/units.h"
+
+using namespace allpix;
+
+namespace {
+    /**
+     * @brief Result of a single benchmark
+     */
+    struct Result {
+        std::string name;
+        size_t iterations;
+        double time;
+    };
+
+    /**
+     * @brief Runner repeating a benchmark until its total run time exceeds the requested minimum
+     *
+     * Every benchmark is a callable performing a fixed number of operations and returning a value derived from the result,
+     * which is accumulated such that the compiler cannot remove the benchmarked code.
+     */
+    class Runner {
+    public:
+        Runner(std::string filter, double min_time) : filter_(std::move(filter)), min_time_(min_time) {}
+
+        /**
+         * @brief Check if a benchmark is selected by the filter
+         * @param name Name of the benchmark
+         */
+        bool selected(const std::string& name) const {
+            return filter_.empty() || name.find(filter_) != std::string::npos;
+        }
+
+        /**
+         * @brief Run a benchmark if selected and store its result
+         * @param name       Name of the benchmark
+         * @param operations Number of operations performed per call of the benchmark function
+         * @param func       Benchmark function
+         */
+        template <typename Func> void run(const std::string& name, size_t operations, Func&& func) {
+            if(!selected(name)) {
+                return;
+            }
+            LOG(STATUS) << "Running benchmark " << name;
+
+            // Warm up caches and lazily initialized state:
+            sink_ = sink_ + static_cast<double>(func());
+
+            size_t calls = 1;
+            while(true) {
+                auto start = std::chrono::steady_clock::now();
+                for(size_t call = 0; call < calls; ++call) {
+                    sink_ = sink_ + static_cast<double>(func());
+                }
+                auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if(time >= min_time_) {
+                    results_.push_back({name, calls * operations, time});
+                    LOG(INFO) << name << ": " << time / static_cast<double>(calls * operations) * 1e9 << " ns/op";
+                    return;
+                }
+
+                // Extrapolate the number of calls required, growing by at least a factor of two:
+                auto scale = (time > 0 ? 1.2 * min_time_ / time : 10.);
+                calls = std::max(2 * calls, static_cast<size_t>(static_cast<double>(calls) * scale));
+            }
+        }
+
+        /**
+         * @brief Write the results as JSON document
+         * @param out Output stream
+         */
+        void write(std::ostream& out) const {
+            out << "{" << std::endl;
+            out << "  \"version\": \"" << ALLPIX_PROJECT_VERSION << "\"," << std::endl;
+            out << "  \"min_time\": " << min_time_ << "," << std::endl;
+            out << "  \"benchmarks\": [";
+            for(size_t i = 0; i < results_.size(); ++i) {
+                const auto& result = results_[i];
+                out << (i == 0 ? "" : ",") << std::endl;
+                out << "    {\"name\": \"" << result.name << "\", \"iterations\": " << result.iterations
+                    << ", \"time\": " << result.time
+                    << ", \"ns_per_op\": " << result.time / static_cast<double>(result.iterations) * 1e9
+                    << ", \"ops_per_s\": " << static_cast<double>(result.iterations) / result.time << "}";
+            }
+            out << std::endl << "  ]" << std::endl << "}" << std::endl;
+        }
+
+    private:
+        std::string filter_;
+        double min_time_;
+        std::vector<Result> results_;
+        volatile double sink_{};
+    };
+
+    /**
+     * @brief Create a detector with a monolithic pixel model of 64x64 pixels of 50um pitch and a 300um thick sensor
+     */
+    std::shared_ptr<Detector> create_detector() {
+        std::istringstream model_config("type = \"monolithic\"\n"
+                                        "number_of_pixels = 64 64\n"
+                                        "pixel_size = 50um 50um\n"
+                                        "sensor_thickness = 300um\n");
+        auto model = std::make_shared<MonolithicPixelDetectorModel>("benchmark", ConfigReader(model_config, "benchmark"));
+        return std::make_shared<Detector>(
+            "benchmark", model, ROOT::Math::XYZPoint(0, 0, 0), ROOT::Math::Rotation3D());
+    }
+
+    /**
+     * @brief Generate a synthetic vector field with a dominant drift component of about 10kV/cm along z
+     * @param dimensions Number of bins in x, y and z
+     * @param seed       Seed of the random number generator
+     */
+    std::shared_ptr<std::vector<double>> create_field(const std::array<size_t, 3>& dimensions, uint64_t seed) {
+        std::mt19937_64 random_generator(seed);
+        std::uniform_real_distribution<double> distribution(-1., 1.);
+        auto unit = Units::get(1., "V/cm");
+        auto field = std::make_shared<std::vector<double>>(dimensions[0] * dimensions[1] * dimensions[2] * 3);
+        for(size_t i = 0; i < field->size(); i += 3) {
+            (*field)[i] = 100. * unit * distribution(random_generator);
+            (*field)[i + 1] = 100. * unit * distribution(random_generator);
+            (*field)[i + 2] = (-10000. + 1000. * distribution(random_generator)) * unit;
+        }
+        return field;
+    }
+
+    /**
+     * @brief Generate random positions within the sensor of the detector
+     * @param detector Detector to generate positions in
+     * @param count    Number of positions
+     * @param seed     Seed of the random number generator
+     */
+    std::vector<ROOT::Math::XYZPoint>
+    create_positions(const std::shared_ptr<Detector>& detector, size_t count, uint64_t seed) {
+        auto model = detector->getModel();
+        auto center = model->getSensorCenter();
+        auto size = model->getSensorSize();
+
+        std::mt19937_64 random_generator(seed);
+        std::uniform_real_distribution<double> distribution(-0.5, 0.5);
+        std::vector<ROOT::Math::XYZPoint> positions;
+        positions.reserve(count);
+        for(size_t i = 0; i < count; ++i) {
+            positions.emplace_back(center.x() + size.x() * distribution(random_generator),
+                                   center.y() + size.y() * distribution(random_generator),
+                                   center.z() + size.z() * distribution(random_generator));
+        }
+        return positions;
+    }
+} // namespace
+
+/**
+ * @brief Main function running the application
+ */
+int main(int argc, const char* argv[]) {
+
+    int return_code = 0;
+    try {
+
+        // Register the default set of units with this executable:
+        register_units();
+
+        // Log to the error stream to keep the standard output for the results
+        Log::addStream(std::cerr);
+        Log::setReportingLevel(LogLevel::WARNING);
+
+        // Parse arguments
+        bool print_help = false;
+        std::string filter;
+        std::string file_output;
+        double min_time = 0.5;
+        unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+        for(int i = 1; i < argc; i++) {
+            if(strcmp(argv[i], "-h") == 0) {
+                print_help = true;
+            } else if(strcmp(argv[i], "-v") == 0 && (i + 1 < argc)) {
+                try {
+                    LogLevel log_level = Log::getLevelFromString(std::string(argv[++i]));
+                    Log::setReportingLevel(log_level);
+                } catch(std::invalid_argument& e) {
+                    LOG(ERROR) << "Invalid verbosity level \"" << std::string(argv[i]) << "\", ignoring overwrite";
+                }
+            } else if(strcmp(argv[i], "--filter") == 0 && (i + 1 < argc)) {
+                filter = std::string(argv[++i]);
+            } else if(strcmp(argv[i], "--output") == 0 && (i + 1 < argc)) {
+                file_output = std::string(argv[++i]);
+            } else if(strcmp(argv[i], "--min-time") == 0 && (i + 1 < argc)) {
+                min_time = std::stod(argv[++i]);
+            } else if(strcmp(argv[i], "--threads") == 0 && (i + 1 < argc)) {
+                threads = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } else {
+                LOG(ERROR) << "Unrecognized command line argument \"" << argv[i] << "\"";
+                print_help = true;
+                return_code = 1;
+            }
+        }
+
+        // Print help if requested
+        if(print_help) {
+            std::cout << "Allpix Squared Kernel Benchmark" << std::endl;
+            std::cout << std::endl;
+            std::cout << "Usage: benchmark_kernels <options>" << std::endl;
+            std::cout << std::endl;
+            std::cout << "Options:" << std::endl;
+            std::cout << "  --filter <name>     only run benchmarks containing the given name" << std::endl;
+            std::cout << "  --output <file>     write the JSON results to a file instead of the standard output"
+                      << std::endl;
+            std::cout << "  --min-time <s>      minimum run time of every benchmark in seconds. Default is 0.5" << std::endl;
+            std::cout << "  --threads <n>       number of workers for the thread pool benchmark. Default is the number"
+                      << std::endl;
+            std::cout << "                      of concurrent threads supported by the system" << std::endl;
+            std::cout << "  -v <level>          verbosity level, overwriting the default of WARNING" << std::endl;
+            std::cout << std::endl;
+            std::cout << "For more help, please see <https://cern.ch/allpix-squared>" << std::endl;
+            return return_code;
+        }
+
+        Runner runner(filter, min_time);
+
+        // Detector fields, sampled at random positions in the sensor
+        const size_t points = 1024;
+        auto detector = create_detector();
+        auto positions = create_positions(detector, points, 1);
+        detector->setElectricFieldGrid(create_field({25, 25, 100}, 2),
+                                       {25, 25, 100},
+                                       {1., 1.},
+                                       {0., 0.},
+                                       {detector->getModel()->getSensorCenter().z() -
+                                            detector->getModel()->getSensorSize().z() / 2.,
+                                        detector->getModel()->getSensorCenter().z() +
+                                            detector->getModel()->getSensorSize().z() / 2.});
+        runner.run("field_grid_get", points, [&]() {
+            double sum = 0;
+            for(const auto& position : positions) {
+                sum += detector->getElectricField(position).z();
+            }
+            return sum;
+        });
+
+        auto function_detector = create_detector();
+        function_detector->setElectricFieldFunction(
+            [unit = Units::get(1., "V/cm")](const ROOT::Math::XYZPoint& pos) {
+                return ROOT::Math::XYZVector(0, 0, (-10000. - 1e4 * pos.z()) * unit);
+            },
+            {detector->getModel()->getSensorCenter().z() - detector->getModel()->getSensorSize().z() / 2.,
+             detector->getModel()->getSensorCenter().z() + detector->getModel()->getSensorSize().z() / 2.},
+            FieldType::LINEAR);
+        runner.run("field_function_get", points, [&]() {
+            double sum = 0;
+            for(const auto& position : positions) {
+                sum += function_detector->getElectricField(position).z();
+            }
+            return sum;
+        });
+
+        // Mobility and recombination models, evaluated for a range of field strengths and doping concentrations
+        std::vector<std::pair<double, double>> conditions;
+        std::mt19937_64 random_generator(3);
+        std::uniform_real_distribution<double> uniform(0., 1.);
+        for(size_t i = 0; i < points; ++i) {
+            conditions.emplace_back(Units::get(1e5 * uniform(random_generator), "V/cm"),
+                                    Units::get(std::pow(10., 12. + 6. * uniform(random_generator)), "/cm/cm/cm"));
+        }
+        for(const auto& model : {"jacoboni", "canali", "hamburg", "masetti", "arora"}) {
+            Mobility mobility(model, 293.15, true);
+            runner.run(std::string("mobility_") + model, 2 * points, [&]() {
+                double sum = 0;
+                for(const auto& [efield, doping] : conditions) {
+                    sum += mobility(CarrierType::ELECTRON, efield, doping);
+                    sum += mobility(CarrierType::HOLE, efield, doping);
+                }
+                return sum;
+            });
+        }
+        std::vector<double> survival(points);
+        std::generate(survival.begin(), survival.end(), [&]() { return uniform(random_generator); });
+        for(const auto& model : {"srh", "auger", "srh_auger"}) {
+            Recombination recombination(model, true);
+            runner.run(std::string("recombination_") + model, points, [&]() {
+                size_t recombined = 0;
+                for(size_t i = 0; i < points; ++i) {
+                    recombined += recombination(
+                        CarrierType::ELECTRON, conditions[i].second, survival[i], Units::get(0.1, "ns")) ? 1 : 0;
+                }
+                return recombined;
+            });
+        }
+
+        // Runge-Kutta integration of the drift of an electron through the grid field
+        const size_t steps = 100;
+        Mobility mobility("jacoboni", 293.15);
+        auto carrier_velocity = [&](double, const Eigen::Vector3d& cur_pos) -> Eigen::Vector3d {
+            auto efield = detector->getElectricField(ROOT::Math::XYZPoint(cur_pos.x(), cur_pos.y(), cur_pos.z()));
+            Eigen::Vector3d field(efield.x(), efield.y(), efield.z());
+            return -mobility(CarrierType::ELECTRON, field.norm(), 0.) * field;
+        };
+        size_t start = 0;
+        runner.run("runge_kutta_step", steps, [&]() {
+            const auto& position = positions[start++ % points];
+            auto runge_kutta = make_runge_kutta(tableau::RK5,
+                                                carrier_velocity,
+                                                Units::get(0.01, "ns"),
+                                                Eigen::Vector3d(position.x(), position.y(), position.z()));
+            for(size_t step = 0; step < steps; ++step) {
+                runge_kutta.step();
+            }
+            return runge_kutta.getValue().z();
+        });
+
+        // Throughput of the thread pool for small tasks
+        if(runner.selected("thread_pool_submit")) {
+            const size_t tasks = 10000;
+            ThreadPool::registerThreadCount(threads);
+            ThreadPool thread_pool(threads, threads * 128);
+            std::atomic<size_t> counter{};
+            runner.run("thread_pool_submit", tasks, [&]() {
+                for(size_t task = 0; task < tasks; ++task) {
+                    thread_pool.submit([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+                }
+                thread_pool.wait();
+                thread_pool.checkException();
+                return counter.load();
+            });
+            thread_pool.destroy();
+        }
+
+        // Accumulation of induced charge into pulses
+        const size_t charges = 10000;
+        std::vector<std::pair<double, double>> induced;
+        for(size_t i = 0; i < charges; ++i) {
+            induced.emplace_back(100. * (uniform(random_generator) - 0.5),
+                                 Units::get(25. * uniform(random_generator), "ns"));
+        }
+        runner.run("pulse_add_charge", charges, [&]() {
+            Pulse pulse(Units::get(0.01, "ns"));
+            for(const auto& [charge, time] : induced) {
+                pulse.addCharge(charge, time);
+            }
+            return pulse.getCharge();
+        });
+
+        // Convolution of a pulse with the impulse response of a charge-sensitive amplifier
+        const double timestep = Units::get(0.01, "ns");
+        Pulse pulse(timestep);
+        for(const auto& [charge, time] : induced) {
+            pulse.addCharge(std::abs(charge), time / 5.);
+        }
+        std::vector<double> response(static_cast<size_t>(Units::get(500., "ns") / timestep));
+        for(size_t i = 0; i < response.size(); ++i) {
+            auto time = timestep * static_cast<double>(i);
+            response[i] = std::exp(-time / Units::get(50., "ns")) - std::exp(-time / Units::get(1., "ns"));
+        }
+        std::vector<double> amplified(response.size());
+        runner.run("csa_convolution", 1, [&]() {
+            convolve_pulse(pulse.getPulse(), response, amplified);
+            return amplified.back();
+        });
+
+        // Loading of field files in the APF and INIT format
+        if(runner.selected("field_parser")) {
+            auto directory = std::filesystem::temp_directory_path() / "allpix_benchmark_kernels";
+            auto cache_directory = directory / "cache";
+            std::filesystem::create_directories(cache_directory);
+
+            FieldData<double> field_data("benchmark", {50, 50, 100}, {50e-3, 50e-3, 300e-3}, create_field({50, 50, 100}, 4));
+            FieldWriter<double> field_writer(FieldQuantity::VECTOR);
+            for(const auto& [format, type] :
+                {std::make_pair("apf", FileType::APF), std::make_pair("init", FileType::INIT)}) {
+                auto file_name = (directory / (std::string("field.") + format)).string();
+                field_writer.writeFile(field_data, file_name, type, "V/cm");
+                auto load = [&]() {
+                    // Every parser caches the fields it has read, use a new one per load:
+                    FieldParser<double> field_parser(FieldQuantity::VECTOR);
+                    return field_parser.getByFileName(file_name, "V/cm", cache_directory.string()).getData()->size();
+                };
+                if(type == FileType::INIT) {
+                    // Empty the cache directory to measure the parsing of the text file:
+                    runner.run("field_parser_init", 1, [&]() {
+                        std::filesystem::remove_all(cache_directory);
+                        return load();
+                    });
+
+                    // The cached loads should read the sidecar file written by a previous load and never replace it:
+                    if(runner.selected("field_parser_init_cached")) {
+                        auto sidecar_time = [&]() {
+                            std::vector<std::filesystem::file_time_type> times;
+                            for(const auto& entry : std::filesystem::directory_iterator(cache_directory)) {
+                                times.push_back(std::filesystem::last_write_time(entry));
+                            }
+                            if(times.size() != 1) {
+                                throw std::runtime_error("expected exactly one sidecar file in " +
+                                                         cache_directory.string() + ", found " +
+                                                         std::to_string(times.size()));
+                            }
+                            return times.front();
+                        };
+                        load();
+                        auto sidecar_written = sidecar_time();
+                        runner.run("field_parser_init_cached", 1, load);
+                        if(sidecar_time() != sidecar_written) {
+                            throw std::runtime_error("cached INIT loads did not use the sidecar file");
+                        }
+                    }
+                } else {
+                    runner.run("field_parser_apf", 1, load);
+                }
+            }
+            std::filesystem::remove_all(directory);
+        }
+
+        // Write the results
+        if(file_output.empty()) {
+            runner.write(std::cout);
+        } else {
+            std::ofstream file(file_output);
+            if(!file) {
+                throw std::invalid_argument("cannot open output file \"" + file_output + "\"");
+            }
+            runner.write(file);
+            LOG(STATUS) << "Results written to " << file_output;
+        }
+    } catch(std::exception& e) {
+        LOG(FATAL) << "Fatal internal error" << std::endl << e.what() << std::endl << "Cannot continue.";
+        return_code = 127;
+    }
+
+    // Finish the logging
+    Log::finish();
+
+    return return_code;
+}